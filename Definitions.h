@@ -4,7 +4,8 @@
 #include "SDL.h"
 #include "SDL_ttf.h"
 #include "SDL_image.h"
-#include <cstring>			// memset
+#include <cstring>			// memset, strstr
+#include <climits>			// INT_MAX
 #include <string>
 #include <memory>			// std::unique_ptr, std::shared_ptr, std::weak_ptr
 #include <ios>
@@ -14,9 +15,16 @@
 //#include <queue>
 #include <math.h>
 
+#include <thread>			// PathFindBatch workers
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
 #include <unordered_map>
+#include <list>
 #include <array>
 #include <algorithm>		// std::make_heap
+#include <functional>		// ForEachBenchmarkMap callbacks
 
 #define BIT(x) 1 << x
 #define DEG2RAD(angle) ( angle * ((float)(M_PI)/180.0f) )
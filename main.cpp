@@ -132,18 +132,13 @@ float GetAngle(const Vec2_t & v) {
 typedef struct GameObject_s GameObject_t;
 
 // GridCell_t
+// DEBUG: per-search pathfinding state lives in SearchContext_t, so searches only read gameGrid
 typedef struct GridCell_s {
-	// pathfinding
-	GridCell_s * parent = nullptr;		// originating cell to set the path back from the goal
-	int gCost = 0;				// distance from start cell to this cell
-	int hCost = 0;				// distance from this cell to goal
-	int fCost = 0;				// sum of gCost and hCost
 	int gridRow;				// index within gameGrid
 	int gridCol;				// index within gameGrid
-	bool inOpenSet = false;		// expidites PathFind openSet searches
-	bool inClosedSet = false;	// expidites PathFind closedSet searches
 
 	bool solid;												// triggers collision
+	int component;											// connectivity label shared by mutually reachable cells, -1 if solid
 	SDL_Rect bounds;										// world location and cell size
 	SDL_Point center;										// cached bounds centerpoint for quicker pathfinding
 	std::vector<std::shared_ptr<GameObject_t>> contents;	// monsters, missiles, and/or Goodman
@@ -155,6 +150,7 @@ constexpr const int gameHeight		= 600;
 constexpr const int cellSize		= 16;	// 16x16 square cells
 constexpr const int gridRows		= gameWidth / cellSize;
 constexpr const int gridCols		= gameHeight / cellSize;
+constexpr const int gridCellCount	= gridRows * gridCols;
 
 // gameGrid
 struct {
@@ -162,6 +158,675 @@ struct {
 	std::array<std::array<GridCell_t, gridCols>, gridRows> cells;	// spatial partitioning of play area
 } gameGrid;
 
+// Path_t
+// compact sequence of gameGrid cells stored as 16-bit cell indexes (see CellIndex), a quarter the size of pointers
+// reads back as GridCell_t pointers through a std::vector-like interface, so paths never need expanding
+static_assert(gridCellCount <= 65536, "Path_t cell indexes must fit in 16 bits");
+typedef struct Path_s {
+	// random access iterator yielding GridCell_t pointers
+	// DEBUG: read-only, dereferencing returns the pointer by value
+	struct iterator {
+		typedef std::random_access_iterator_tag		iterator_category;
+		typedef GridCell_t *						value_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef GridCell_t * const *				pointer;
+		typedef GridCell_t *						reference;
+
+		const Uint16 *	index;
+
+		GridCell_t *	operator*() const								{ return ToCell(*index); }
+		GridCell_t *	operator[](const difference_type offset) const	{ return ToCell(index[offset]); }
+		iterator &		operator++()									{ ++index; return *this; }
+		iterator		operator++(int)									{ iterator old = *this; ++index; return old; }
+		iterator &		operator--()									{ --index; return *this; }
+		iterator		operator--(int)									{ iterator old = *this; --index; return old; }
+		iterator &		operator+=(const difference_type offset)		{ index += offset; return *this; }
+		iterator &		operator-=(const difference_type offset)		{ index -= offset; return *this; }
+		iterator		operator+(const difference_type offset) const	{ return iterator{ index + offset }; }
+		iterator		operator-(const difference_type offset) const	{ return iterator{ index - offset }; }
+		difference_type	operator-(const iterator & other) const			{ return index - other.index; }
+		bool			operator==(const iterator & other) const		{ return index == other.index; }
+		bool			operator!=(const iterator & other) const		{ return index != other.index; }
+		bool			operator<(const iterator & other) const			{ return index < other.index; }
+		bool			operator>(const iterator & other) const			{ return index > other.index; }
+		bool			operator<=(const iterator & other) const		{ return index <= other.index; }
+		bool			operator>=(const iterator & other) const		{ return index >= other.index; }
+	};
+	typedef iterator							const_iterator;
+	typedef std::reverse_iterator<iterator>		reverse_iterator;
+
+	std::vector<Uint16>	cells;
+
+	static GridCell_t * ToCell(const Uint16 index) {
+		return &gameGrid.cells[index / gridCols][index % gridCols];
+	}
+
+	static Uint16 ToIndex(const GridCell_t * cell) {
+		return (Uint16)(cell->gridRow * gridCols + cell->gridCol);
+	}
+
+	bool				empty() const							{ return cells.empty(); }
+	size_t				size() const							{ return cells.size(); }
+	void				clear()									{ cells.clear(); }
+	void				push_back(const GridCell_t * cell)		{ cells.push_back(ToIndex(cell)); }
+	void				pop_back()								{ cells.pop_back(); }
+	GridCell_t *		front() const							{ return ToCell(cells.front()); }
+	GridCell_t *		back() const							{ return ToCell(cells.back()); }
+	GridCell_t *		operator[](const size_t index) const	{ return ToCell(cells[index]); }
+	GridCell_t *		at(const size_t index) const			{ return ToCell(cells.at(index)); }
+	iterator			begin() const							{ return iterator{ cells.data() }; }
+	iterator			end() const								{ return iterator{ cells.data() + cells.size() }; }
+	reverse_iterator	rbegin() const							{ return reverse_iterator(end()); }
+	reverse_iterator	rend() const							{ return reverse_iterator(begin()); }
+	void				reverse()								{ std::reverse(cells.begin(), cells.end()); }
+
+	// copies any range of GridCell_t pointers
+	template<typename InputIterator>
+	void assign(InputIterator first, const InputIterator last) {
+		cells.clear();
+		for (; first != last; ++first)
+			cells.push_back(ToIndex(*first));
+	}
+
+	// copies the indexes of another path's range directly
+	void insert(const iterator position, const iterator first, const iterator last) {
+		cells.insert(cells.begin() + (position.index - cells.data()), first.index, last.index);
+	}
+} Path_t;
+
+// OpenSetMode_t
+// PathFind open set implementations
+typedef enum {
+	OPENSET_MAKE_HEAP,		// re-heapify and erase the front on every pop (original behavior, kept as a benchmark baseline)
+	OPENSET_BINARY_HEAP,	// indexed binary heap with in-place decrease-key
+	OPENSET_BUCKET_QUEUE	// one bucket per integer fCost, stale entries are skipped on pop
+} OpenSetMode_t;
+
+OpenSetMode_t openSetMode = OPENSET_BINARY_HEAP;
+
+// OpenSet_t
+// pathfinding priority queue of gameGrid cell indexes (see CellIndex)
+// sorted first by fCost, then by hCost
+// DEBUG: OPENSET_BUCKET_QUEUE breaks hCost ties last-in-first-out instead
+typedef struct OpenSet_s {
+	OpenSetMode_t					mode;
+	std::vector<int>				heap;			// OPENSET_MAKE_HEAP and OPENSET_BINARY_HEAP cell indexes
+	std::vector<std::vector<int>>	buckets;		// OPENSET_BUCKET_QUEUE cell indexes indexed by fCost
+	int								bucketCursor;	// lowest bucket that may hold a live cell
+	int								bucketMax;		// highest bucket used since the last Clear
+	int								count;			// number of queued cells, excluding stale bucket entries
+	std::vector<int>				position;		// per-cell heap index (0 if not heap ordered), -1 if not queued
+	std::vector<int>				fCosts;			// per-cell sort keys, only valid while queued
+	std::vector<int>				hCosts;
+	std::vector<Uint32>				stamps;			// a cell's position is only valid if its stamp matches generation
+	std::vector<Uint32>				bucketStamps;	// a bucket's entries are only valid if its stamp matches generation
+	Uint32							generation;		// current fill of the set, incremented to empty it in O(1)
+
+	// DEBUG: size is the number of distinct indexes, gridCellCount unless searching more than cells
+	OpenSet_s(const int size = gridCellCount)
+		:	mode(OPENSET_BINARY_HEAP),
+			bucketCursor(INT_MAX),
+			bucketMax(-1),
+			count(0),
+			position(size, -1),
+			fCosts(size, 0),
+			hCosts(size, 0),
+			stamps(size, 0),
+			generation(0) {
+	};
+
+	bool Empty() const {
+		return count == 0;
+	}
+
+	bool Contains(const int cell) const {
+		return stamps[cell] == generation && position[cell] >= 0;
+	}
+
+	// adds the cell, or updates its sort keys in place if already queued
+	void Push(const int cell, const int fCost, const int hCost) {
+		if (Contains(cell)) {
+			Update(cell, fCost, hCost);
+			return;
+		}
+
+		fCosts[cell] = fCost;
+		hCosts[cell] = hCost;
+		stamps[cell] = generation;
+		count++;
+		switch (mode) {
+			case OPENSET_MAKE_HEAP: 
+				position[cell] = 0;
+				heap.push_back(cell);
+				break;
+			case OPENSET_BINARY_HEAP: 
+				heap.push_back(cell);
+				SiftUp((int)heap.size() - 1);
+				break;
+			case OPENSET_BUCKET_QUEUE:
+				position[cell] = 0;
+				PushBucket(cell, fCost);
+				break;
+		}
+	}
+
+	// decrease-key (or increase-key) of an already queued cell
+	void Update(const int cell, const int fCost, const int hCost) {
+		int oldFCost = fCosts[cell];
+		fCosts[cell] = fCost;
+		hCosts[cell] = hCost;
+		switch (mode) {
+			case OPENSET_MAKE_HEAP:
+				break;		// DEBUG: re-heapified on the next Pop
+			case OPENSET_BINARY_HEAP:
+				SiftUp(position[cell]);
+				SiftDown(position[cell]);
+				break;
+			case OPENSET_BUCKET_QUEUE:
+				if (fCost != oldFCost)
+					PushBucket(cell, fCost);	// DEBUG: the old entry goes stale
+				break;
+		}
+	}
+
+	// removes and returns the lowest cost cell
+	// DEBUG: never call on an empty set
+	int Pop() {
+		int cell = -1;
+		switch (mode) {
+			case OPENSET_MAKE_HEAP:
+				std::make_heap(heap.begin(), heap.end(), [this](auto && a, auto && b) { return Before(b, a); });
+				cell = heap.front();
+				heap.erase(heap.begin());
+				break;
+			case OPENSET_BINARY_HEAP:
+				cell = heap.front();
+				heap.front() = heap.back();
+				heap.pop_back();
+				if (!heap.empty())
+					SiftDown(0);
+				break;
+			case OPENSET_BUCKET_QUEUE:
+				while (cell == -1 && bucketCursor <= bucketMax) {
+					auto & bucket = Bucket(bucketCursor);
+					while (!bucket.empty()) {
+						int entry = bucket.back();
+						bucket.pop_back();
+						if (Contains(entry) && fCosts[entry] == bucketCursor) {
+							cell = entry;
+							break;
+						}
+					}
+					if (bucket.empty() && cell == -1)
+						bucketCursor++;
+				}
+				break;
+		}
+		position[cell] = -1;
+		count--;
+		return cell;
+	}
+
+	// returns the lowest cost cell without removing it
+	// DEBUG: never call on an empty set
+	int Top() {
+		switch (mode) {
+			case OPENSET_MAKE_HEAP:
+				std::make_heap(heap.begin(), heap.end(), [this](auto && a, auto && b) { return Before(b, a); });
+				return heap.front();
+			case OPENSET_BINARY_HEAP:
+				return heap.front();
+			case OPENSET_BUCKET_QUEUE:
+				while (bucketCursor <= bucketMax) {
+					auto & bucket = Bucket(bucketCursor);
+					while (!bucket.empty()) {
+						int entry = bucket.back();
+						if (Contains(entry) && fCosts[entry] == bucketCursor)
+							return entry;
+						bucket.pop_back();
+					}
+					bucketCursor++;
+				}
+				break;
+		}
+		return -1;
+	}
+
+	// removes a queued cell
+	void Remove(const int cell) {
+		switch (mode) {
+			case OPENSET_MAKE_HEAP:
+				heap.erase(std::find(heap.begin(), heap.end(), cell));
+				break;
+			case OPENSET_BINARY_HEAP: {
+				int index = position[cell];
+				int last = heap.back();
+				heap.pop_back();
+				if (last != cell) {
+					heap[index] = last;
+					position[last] = index;
+					SiftUp(index);
+					SiftDown(position[last]);
+				}
+				break;
+			}
+			case OPENSET_BUCKET_QUEUE:
+				break;		// DEBUG: its bucket entry goes stale
+		}
+		position[cell] = -1;
+		count--;
+	}
+
+	// empties the set in O(1), cells and buckets left over are discarded lazily by their stale stamps
+	void Clear() {
+		heap.clear();
+		bucketCursor = INT_MAX;
+		bucketMax = -1;
+		count = 0;
+		if (++generation == 0) {	// DEBUG: rare wrap-around, stale stamps could match again
+			std::fill(stamps.begin(), stamps.end(), 0);
+			std::fill(bucketStamps.begin(), bucketStamps.end(), 0);
+			generation = 1;
+		}
+	}
+
+	// sort order
+	bool Before(const int a, const int b) const {
+		return fCosts[a] < fCosts[b] || (fCosts[a] == fCosts[b] && hCosts[a] < hCosts[b]);
+	}
+
+	void SiftUp(int index) {
+		int cell = heap[index];
+		while (index > 0) {
+			int parent = (index - 1) / 2;
+			if (!Before(cell, heap[parent]))
+				break;
+			heap[index] = heap[parent];
+			position[heap[index]] = index;
+			index = parent;
+		}
+		heap[index] = cell;
+		position[cell] = index;
+	}
+
+	void SiftDown(int index) {
+		int cell = heap[index];
+		int size = heap.size();
+		while (true) {
+			int child = 2 * index + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && Before(heap[child + 1], heap[child]))
+				child++;
+			if (!Before(heap[child], cell))
+				break;
+			heap[index] = heap[child];
+			position[heap[index]] = index;
+			index = child;
+		}
+		heap[index] = cell;
+		position[cell] = index;
+	}
+
+	// the bucket of fCost, first emptied if left over from an earlier fill
+	std::vector<int> & Bucket(const int fCost) {
+		if (bucketStamps[fCost] != generation) {
+			buckets[fCost].clear();
+			bucketStamps[fCost] = generation;
+		}
+		return buckets[fCost];
+	}
+
+	void PushBucket(const int cell, const int fCost) {
+		if (fCost >= (int)buckets.size()) {
+			buckets.resize(fCost + 1);
+			bucketStamps.resize(fCost + 1, generation);
+		}
+		Bucket(fCost).push_back(cell);
+		if (fCost < bucketCursor)
+			bucketCursor = fCost;
+		if (fCost > bucketMax)
+			bucketMax = fCost;
+	}
+} OpenSet_t;
+
+// SearchContext_t
+// per-search A* state of every gameGrid cell, indexed by CellIndex
+// each thread running searches needs its own context
+typedef struct SearchContext_s {
+	OpenSet_t				openSet;
+	std::vector<int>		parents;		// originating cell to set the path back from the goal
+	std::vector<int>		gCosts;			// distance from start cell to this cell
+	std::vector<Uint32>		closedStamps;	// a cell is in the closedSet if its stamp matches generation
+	Uint32					generation;		// current search, incremented to empty the closedSet in O(1)
+	int						expansions;		// cells closed by the current search
+	int						unitRadius;		// clearance each step needs, see UnitFits, -1 for any navGraph step
+	int						congestion;		// cost per unit standing in each cell stepped onto, see density, 0 ignores units
+
+	// DEBUG: parents and gCosts are only valid for cells in the openSet or closedSet of the current search
+	SearchContext_s()
+		:	parents(gridCellCount, -1),
+			gCosts(gridCellCount, 0),
+			closedStamps(gridCellCount, 0),
+			generation(0),
+			expansions(0),
+			unitRadius(-1),
+			congestion(0) {
+	};
+
+	// start a new search, discarding all state from the last one in O(1)
+	// DEBUG: congestion is left as the caller set it
+	void Reset() {
+		openSet.Clear();
+		expansions = 0;
+		unitRadius = -1;
+		if (++generation == 0) {	// DEBUG: rare wrap-around, stale stamps could match again
+			std::fill(closedStamps.begin(), closedStamps.end(), 0);
+			generation = 1;
+		}
+	}
+
+	bool InClosedSet(const int cell) const {
+		return closedStamps[cell] == generation;
+	}
+
+	void Close(const int cell) {
+		closedStamps[cell] = generation;
+		expansions++;
+	}
+} SearchContext_t;
+
+SearchContext_t mainSearchContext;	// used by all searches on the main thread
+
+// any-angle paths, see SmoothPath
+// PathFind keeps only the waypoints where the path must turn around collision
+bool anyAnglePaths = true;
+
+// local path repair, see RepairPath
+// walkers detour around stationary units blocking the next few cells of their path,
+// instead of waiting for them to move, since PathFind ignores units entirely
+bool localPathRepair = true;
+constexpr const int repairLookahead	= 4;	// cells ahead on the path checked for blockers
+constexpr const int repairRejoin	= 8;	// cells past the first blocker to look for a clear cell to rejoin the path
+constexpr const int repairMargin	= 3;	// cells the detour search may stray beyond the box around the blockage
+
+// HeuristicMode_t
+// PathFind cost estimate to the goal cell, see GetHeuristic
+typedef enum {
+	HEURISTIC_OCTILE,		// GetDistance, ignores walls
+	HEURISTIC_LANDMARKS		// ALT, the best triangle inequality bound over the landmarks tables (never below octile)
+} HeuristicMode_t;
+
+HeuristicMode_t heuristicMode = HEURISTIC_OCTILE;
+
+// ALT landmarks, see BuildLandmarks
+constexpr const int landmarkCount = 8;
+struct {
+	std::vector<int>	cells;			// CellIndexes of the chosen landmarks, at most landmarkCount
+	std::vector<int>	distances;		// by CellIndex * landmarkCount + landmark, cost from the landmark, -1 if unreachable
+} landmarks;
+
+// PathFindMode_t
+// search algorithm used by PathFind, all produce the same paths format
+typedef enum {
+	PATHFIND_ASTAR,			// expands every neighbor of every cell
+	PATHFIND_JPS,			// jump point search, only expands cells where the optimal route may turn
+	PATHFIND_JPS_PLUS,		// jump point search reading jumps from jumpTable instead of scanning the grid
+	PATHFIND_HPA,			// hierarchical search of cluster entrances, then refined within each cluster (near-optimal)
+	PATHFIND_BIDIRECTIONAL,	// A* from both ends at once, for long cross-map orders
+	PATHFIND_FIRST_MOVES,	// follows the baked firstMoves table without searching, A* if it is missing
+	PATHFIND_NAVMESH		// searches navMesh regions, then string-pulls the corridor (any-angle, near-optimal)
+} PathFindMode_t;
+
+PathFindMode_t pathFindMode = PATHFIND_ASTAR;
+
+// compressed all-pairs first moves, see BakeFirstMoves
+// row s holds, for every target CellIndex, the neighborOffsets direction of the first step on a shortest path from s
+// run-length encoded as (first target << 4 | direction), solid and walled off targets extend whichever run they follow
+// DEBUG: optional offline precompute (-bakemoves), saved beside the collision map and loaded by InitGame
+static_assert(gridCellCount <= 4096, "firstMoves targets must fit in 12 bits");
+constexpr const Uint16 firstMoveNone = 8;	// no step leads to the target
+struct {
+	std::vector<int>		offsets;					// by CellIndex, first run of the row, with runs.size() appended, empty if not baked
+	std::vector<Uint16>		runs;
+	size_t					budget = 1 << 20;			// bytes, bakes and loads larger than this are dropped
+	int						unitRadius = -1;			// unit size the moves were baked for, see UnitFits
+	bool					cornerCutting = true;		// navGraph option the moves were baked with
+	Uint32					checksum = 0;				// CollisionChecksum the moves were baked for
+} firstMoves;
+
+const char * firstMovesFile = "graphics/collision.moves";
+
+// JPS+ jump distances, see BakeJumpTable
+// for each cell and neighborOffsets direction
+// > 0 is the number of steps to the next jump point
+// <= 0 is minus the number of steps before hitting a wall or the map edge
+struct {
+	std::vector<std::array<Sint16, 8>>	distances;		// by CellIndex, empty if not baked
+	int									unitRadius = -1;	// unit size the jumps were baked for, see BakedUnitRadius
+} jumpTable;
+
+// HPA* cluster grid
+constexpr const int clusterSize		= 10;	// 10x10 cells per cluster, less along the bottom and right map edges
+constexpr const int clusterRows		= (gridRows + clusterSize - 1) / clusterSize;
+constexpr const int clusterCols		= (gridCols + clusterSize - 1) / clusterSize;
+constexpr const int clusterCount	= clusterRows * clusterCols;
+
+// ClusterEdge_t
+// HPA* abstract graph edge
+typedef struct ClusterEdge_s {
+	int cell;		// CellIndex of the entrance at the other end
+	int cost;		// length of the cell-level route there
+} ClusterEdge_t;
+
+// HPA* abstract graph, see BuildHierarchy
+// its nodes are the entrance cells paired up across cluster borders
+struct {
+	std::array<std::vector<int>, clusterCount>	entrances;		// entrance CellIndexes within each cluster
+	std::vector<std::vector<ClusterEdge_t>>		intraEdges;		// by CellIndex, routes to the other entrances of the same cluster
+	std::vector<std::vector<ClusterEdge_t>>		interEdges;		// by CellIndex, steps across a border to the paired entrance
+	int											unitRadius = -1;	// unit size the routes were built for, see BakedUnitRadius
+} hierarchy;
+
+// NavRegion_t
+// navMesh node, a rectangle of non-solid cells
+typedef struct NavRegion_s {
+	SDL_Rect			cells;		// { row, col, rows, cols }
+	std::vector<int>	portals;	// navMesh.portals along its border
+} NavRegion_t;
+
+// NavPortal_t
+// border shared by two neighboring NavRegion_t, in world coordinates
+// DEBUG: its ends are inset half a cell from the walls, so paths keep to cell centers around corners
+typedef struct NavPortal_s {
+	int			regions[2];		// lower row (or col) side first
+	bool		acrossRows;		// border between two rows, else between two cols
+	SDL_Point	ends[2];		// lower col (or row) end first
+} NavPortal_t;
+
+// navigation mesh merging gameGrid cells into rectangles, see BuildNavMesh
+// DEBUG: regions only meet along edges, so cells joined only by a diagonal squeeze fall back to A*
+struct {
+	std::vector<NavRegion_t>	regions;
+	std::vector<NavPortal_t>	portals;
+	std::vector<int>			regionOf;		// by CellIndex, -1 if solid
+} navMesh;
+
+// least recently used cache of PathFind results, see FindCachedPath
+// DEBUG: guarded by lock since PathFindBatch workers share it, except capacity which is atomic
+// so workers can skip a disabled cache without locking while the main thread changes it
+struct {
+	typedef std::pair<Uint64, Path_t> Entry_t;
+
+	std::list<Entry_t>										entries;			// most recently used first
+	std::unordered_map<Uint64, std::list<Entry_t>::iterator>	lookup;
+	std::mutex												lock;
+	std::atomic<size_t>										capacity{ 256 };	// 0 disables the cache
+	bool													reversible = true;	// a cached A-to-B path also answers B-to-A
+	Uint64													hits = 0;
+	Uint64													misses = 0;
+} pathCache;
+
+// 8-connected neighbor offsets as { row, col }
+// DEBUG: ordered such that the opposite of direction is (7 - direction)
+const SDL_Point neighborOffsets[8] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 }, { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+// diagonal steps may squeeze between two solid cells beside them (the original movement rules)
+// DEBUG: takes effect at the next BakeNavigation
+bool cornerCutting = true;
+
+// NavEdge_t
+// one baked step between neighboring cells
+typedef struct NavEdge_s {
+	Uint16	cell;			// CellIndex stepped onto
+	Uint8	cost;			// GetDistance of the step
+	Uint8	direction;		// neighborOffsets index of the step
+} NavEdge_t;
+
+// baked 8-connected cell graph in compressed sparse row form, see BakeNavGraph
+// searches iterate a cell's edges instead of bounds and solid checking all its neighbors
+// DEBUG: solid cells keep their edges out, so an entity overlapping collision can still search
+struct {
+	std::vector<int>		offsets;		// by CellIndex, first edge of the cell, with edges.size() appended
+	std::vector<NavEdge_t>	edges;			// every valid step out of each cell, in neighborOffsets order
+	std::vector<Uint8>		walkable;		// by CellIndex, bit n set if the neighborOffsets[n] neighbor is on the map and non-solid
+	bool					cornerCutting;	// the option the edges were baked with
+} navGraph;
+
+// size-aware paths, see UnitRadius
+// PathFind and group orders only plan steps that fit the entity's bounds
+bool sizeAwarePaths = true;
+
+// distance transform of gameGrid collision, see BakeClearance
+// a unit (2 * radius + 1) cells across fits centered on any cell with a distance above radius
+struct {
+	std::vector<Uint8>	distances;		// by CellIndex, cells to the nearest solid or off-map cell (chessboard), 0 if solid
+} clearance;
+
+// non-solid cell connectivity, see LabelComponents
+struct {
+	std::vector<int>	sizes;		// number of cells with each GridCell_t::component label
+	int					largest;	// label of the component with the most cells
+} components;
+
+// FlowField_t
+// results of one reverse search from a group order's goal cell
+// shared by every entity given that order
+typedef struct FlowField_s {
+	GridCell_t *						goalCell;
+	int									unitRadius;		// clearance its steps need, see UnitFits
+	std::array<int, gridCellCount>		costs;			// path cost to goalCell by CellIndex, -1 if unreachable
+	std::array<Sint8, gridCellCount>	directions;		// neighborOffsets index of the next step to goalCell, -1 if none
+
+	// returns the next cell towards goalCell
+	// or nullptr if cell is the goalCell or can't reach it
+	GridCell_t * Next(const GridCell_t * cell) const {
+		int direction = directions[cell->gridRow * gridCols + cell->gridCol];
+		if (direction < 0)
+			return nullptr;
+		return &gameGrid.cells[cell->gridRow + neighborOffsets[direction].x][cell->gridCol + neighborOffsets[direction].y];
+	}
+} FlowField_t;
+
+// collision changes since the last BakeNavigation, see SetCellSolid
+struct {
+	std::vector<int>	cells;		// CellIndexes in the order they changed
+	Uint32				bakes;		// BakeNavigation count, a new bake invalidates every DStarLite_t
+} collisionChanges;
+
+constexpr const int dstarInfinity = INT_MAX / 2;		// unreachable, with headroom to add step costs
+
+// DStarLite_t
+// D* Lite search tree kept between searches by one chasing entity
+// rooted at goalIndex and searched towards startIndex, so the entity walking only shifts keyMod,
+// while goal moves and collision changes only repair the affected part of the tree
+typedef struct DStarLite_s {
+	OpenSet_t			openSet;		// sorted by the key { min(g, rhs) + h + keyMod, min(g, rhs) }
+	std::vector<int>	gCosts;			// cost from this cell to goalIndex, by CellIndex
+	std::vector<int>	rhsCosts;		// one step lookahead of gCosts, cells with gCost != rhsCost need expanding
+	int					startIndex;		// -1 until the first search
+	int					goalIndex;
+	int					lastStart;		// startIndex when keyMod was last raised
+	int					keyMod;			// raised as startIndex moves, instead of re-keying the whole openSet
+	size_t				changeCursor;	// collisionChanges.cells already repaired
+	Uint32				bakes;			// collisionChanges.bakes of the tree
+	int					expansions;		// cells expanded by the last search
+
+	DStarLite_s()
+		:	gCosts(gridCellCount, dstarInfinity),
+			rhsCosts(gridCellCount, dstarInfinity),
+			startIndex(-1),
+			goalIndex(-1),
+			lastStart(-1),
+			keyMod(0),
+			changeCursor(0),
+			bakes(0),
+			expansions(0) {
+	};
+} DStarLite_t;
+
+// ChaseMode_t
+// how monsters chasing a target are pathfound, see ChaseTarget
+typedef enum {
+	CHASE_DSTAR_LITE,		// one DStarLite_t repaired per chaser
+	CHASE_REVERSE_TREE		// one FlowField_t rooted at the target's cell shared by every chaser, see UpdateChaseTree
+} ChaseMode_t;
+
+ChaseMode_t chaseMode = CHASE_REVERSE_TREE;
+
+// reverse shortest-path tree from every cell to Goodman's cell, see UpdateChaseTree
+// DEBUG: Goodman is the only chase target, so there's only one tree
+struct {
+	std::shared_ptr<FlowField_t>	field;				// rebuilt or rerooted in place, so chasers keep sharing it
+	size_t							changeCursor = 0;	// collisionChanges.cells already in the tree
+	Uint32							bakes = 0;			// collisionChanges.bakes of the tree
+} chaseTree;
+
+// GroupMoveMode_t
+// how group orders are pathfound
+typedef enum {
+	GROUPMOVE_PATHFIND,		// one PathFind per group member
+	GROUPMOVE_FLOW_FIELD,	// one shared FlowField_t per order
+	GROUPMOVE_COOPERATIVE,	// windowed cooperative A* (WHCA*) through reservationTable, guided by one shared FlowField_t
+	GROUPMOVE_FORMATION		// one PathFind for a leader, the rest steer to their formation spot around it, see FollowLeader
+} GroupMoveMode_t;
+
+GroupMoveMode_t groupMoveMode = GROUPMOVE_FLOW_FIELD;
+
+constexpr const int formationSpacing = 32;	// pixels between neighboring GROUPMOVE_FORMATION spots, room for a unit to pass between two others
+constexpr const int formationJamSteps = 5;	// Walk steps a GROUPMOVE_FORMATION leader may stay stuck before a follower ahead of it takes the lead
+
+// goal slots, see AssignGoalSlots
+// group orders send each member to its own free cell around the goal, instead of all to the goal cell
+bool goalSlots = true;
+
+// per-cell unit occupancy, kept up to date by UpdateCellReferences and ClearCellReferences
+// DEBUG: counts each unit once in every cell its bounds overlap, missiles aren't counted
+struct {
+	std::array<Uint16, gridCellCount>	counts;		// by CellIndex
+} density;
+
+// congestion-aware group orders
+// group order searches charge extra for each unit standing in a cell, spreading groups over alternate routes
+// and members stuck in a jam replan around it
+// DEBUG: paths avoiding units change as they move, so pathCache is skipped
+bool congestionCosts = true;
+constexpr const int congestionCost = 10;	// per unit in a cell stepped onto, one straight step's worth
+constexpr const int congestionReplanSteps = 20;	// Walk steps an ordered unit may stay stuck before it replans, see AvoidCongestion
+
+// WHCA* reservation table, see ReserveCooperativePath
+// each tick is about one cell step at monster walking speed
+constexpr const int reservationWindow		= 16;		// ticks planned ahead, replanned halfway through
+constexpr const int reservationSlots		= reservationWindow + 1;
+constexpr const Uint32 reservationTickMS	= 200;
+struct {
+	std::vector<int>	owners;		// by (tick % reservationSlots) * gridCellCount + CellIndex, guid of the reserving entity
+	std::vector<Uint32>	ticks;		// the tick each owner is for, entries for any other tick are free
+	Uint32				now;		// current tick, see Think
+} reservationTable;
+
+int avoidanceSweeps = 0;	// AvoidCollision calls, see BenchmarkCooperative, BenchmarkGoalSlots, BenchmarkFormation
+
 // selection
 std::vector<std::shared_ptr<GameObject_t>> groupSelection;	// includes all monsters in interior and border cells of selected area
 
@@ -200,10 +865,21 @@ typedef struct GameObject_s {
 	int				groupID;		// selected-group this belongs to
 	bool			selected;		// currently controlled monster
 
-	std::vector<GridCell_t *>		path;				// A* pathfinding results
+	Path_t							path;				// A* pathfinding results
 	std::vector<GridCell_t *>		cells;				// currently occupied gameGrid.cells indexes (between 1 and 4)
 	bool							onPath;				// if the entity is on the back tile of its path
 	SDL_Point *						goal;				// user-defined path objective
+	std::shared_ptr<FlowField_t>	flowField;			// group order steps, used instead of path if set
+	std::weak_ptr<GameObject_t>		chaseTarget;		// entity to keep pathing towards, see ChaseTarget
+	std::shared_ptr<DStarLite_t>	replanner;			// search tree kept while chasing chaseTarget
+	Path_t							reservedCells;		// GROUPMOVE_COOPERATIVE cell for each tick from reservedTick, used instead of flowField if set
+	Uint32							reservedTick;
+	int								stuckSteps;			// Walk steps in a row without moving while ordered, see AvoidCongestion
+	std::weak_ptr<GameObject_t>		leader;				// GROUPMOVE_FORMATION member this steers after, used when path is empty
+	Vec2_t							formationOffset;	// this entity's formation spot as { forward, sideways } of its leader, see FormationHeading
+	std::shared_ptr<Path_t>			trail;				// the leader's path as ordered, shared by its followers to find their way back to it
+	bool							followersLagging;	// GROUPMOVE_FORMATION leader waits every other step for followers still catching up, see FollowLeader
+	bool							waitedLastStep;
 
 	GameObject_s() 
 		:	origin({0, 0}),
@@ -224,8 +900,14 @@ typedef struct GameObject_s {
 			type(OBJECTTYPE_INVALID),
 			guid(-1),
 			onPath(false),
+			goal(nullptr),
 			groupID (-1),
-			selected(false) {
+			selected(false),
+			reservedTick(0),
+			stuckSteps(0),
+			formationOffset(vec2zero),
+			followersLagging(false),
+			waitedLastStep(false) {
 	};
 
 	GameObject_s(const SDL_Point & origin,  const std::string & name, const int guid, ObjectType_t type) 
@@ -244,8 +926,14 @@ typedef struct GameObject_s {
 			type(type),
 			guid(guid),
 			onPath(false),
+			goal(nullptr),
 			groupID(-1),
-			selected(false) {
+			selected(false),
+			reservedTick(0),
+			stuckSteps(0),
+			formationOffset(vec2zero),
+			followersLagging(false),
+			waitedLastStep(false) {
 		switch (type) {
 			case OBJECTTYPE_GOODMAN:
 				bounds = { origin.x + 4, origin.y + 4, 14, 16 };
@@ -282,6 +970,32 @@ std::vector<std::shared_ptr<GameObject_t>> entities;	// monsters and goodman
 std::vector<std::shared_ptr<GameObject_t>> missiles;	// kept separate to allow separate spawning and rendering protocols
 int entityGUID = 0;
 
+// PathRequest_t
+// one entity's search within a PathFindBatch
+typedef struct PathRequest_s {
+	std::shared_ptr<GameObject_t>	entity;			// DEBUG: each entity may only appear once per batch
+	SDL_Point						start;
+	SDL_Point						goal;
+	bool							found;			// PathFind result
+	int								congestion;		// SearchContext_t::congestion of the search
+} PathRequest_t;
+
+// pathfinding worker threads
+// DEBUG: the main thread also runs requests, so this holds one less thread than there are cores
+struct {
+	std::vector<std::thread>		threads;
+	std::mutex						lock;
+	std::condition_variable			wake;			// a new batch is ready, or quit is set
+	std::condition_variable			finished;		// the last pending worker is done with the batch
+	std::vector<PathRequest_t> *	batch;
+	std::atomic<int>				nextRequest;	// next unclaimed index into batch
+	Uint32							batchCount;		// workers run each new batch once
+	int								pending;		// workers yet to finish the current batch
+	bool							quit;
+} pathWorkers;
+
+constexpr const size_t pathBatchSerialLimit = 4;	// smaller batches run on the main thread alone
+
 // AreaContents_t
 // dynamic pathfinding utility
 // DEBUG: convenience typdef for swept AABB collision tests
@@ -401,6 +1115,23 @@ void DrawOutlineText(const char * text, const SDL_Point & location, const SDL_Co
 // DrawPath
 //***************
 void DrawPath(std::shared_ptr<GameObject_t> & entity) {
+
+	// group orders trace their flow field from the entity's current cell
+	if (entity->flowField) {
+		int row = (int)(entity->center.x / cellSize);
+		int col = (int)(entity->center.y / cellSize);
+		if (row < 0 || row >= gridRows || col < 0 || col >= gridCols)
+			return;
+
+		GridCell_t * cell = &gameGrid.cells[row][col];
+		while (cell != nullptr) {
+			SDL_Color drawColor = (cell == entity->flowField->goalCell) ? opaqueRed : opaqueGreen;
+			DrawRect(SDL_Rect{ cell->center.x, cell->center.y, 2, 2 }, drawColor, true);
+			cell = entity->flowField->Next(cell);
+		}
+		return;
+	}
+
 	for (auto && cell : entity->path) {
 		SDL_Color drawColor;
 		if (cell == *(entity->path.begin()))	// DEBUG: this should be the point closest to the goal
@@ -613,6 +1344,140 @@ bool LoadCollision() {
 	return true;
 }
 
+//***************
+// BakeNavGraph
+// rebuilds navGraph from gameGrid collision
+// a step is valid onto any on-map non-solid neighbor,
+// and diagonal steps also need both cells beside them clear unless cornerCutting
+//***************
+void BakeNavGraph() {
+	navGraph.offsets.resize(gridCellCount + 1);
+	navGraph.walkable.assign(gridCellCount, 0);
+	navGraph.edges.clear();
+
+	for (int row = 0; row < gridRows; row++) {
+		for (int col = 0; col < gridCols; col++) {
+			int index = row * gridCols + col;
+			navGraph.offsets[index] = navGraph.edges.size();
+
+			Uint8 & walkable = navGraph.walkable[index];
+			for (int direction = 0; direction < 8; direction++) {
+				int nRow = row + neighborOffsets[direction].x;
+				int nCol = col + neighborOffsets[direction].y;
+				if (nRow >= 0 && nRow < gridRows && nCol >= 0 && nCol < gridCols && !gameGrid.cells[nRow][nCol].solid)
+					walkable |= 1 << direction;
+			}
+
+			for (int direction = 0; direction < 8; direction++) {
+				if (!(walkable & (1 << direction)))
+					continue;
+
+				// the cells beside a diagonal step are its straight row and column components
+				const SDL_Point & offset = neighborOffsets[direction];
+				bool diagonal = offset.x != 0 && offset.y != 0;
+				if (diagonal && !cornerCutting) {
+					int rowSide = offset.x < 0 ? 3 : 4;
+					int colSide = offset.y < 0 ? 1 : 6;
+					if (!(walkable & (1 << rowSide)) || !(walkable & (1 << colSide)))
+						continue;
+				}
+
+				int nIndex = (row + offset.x) * gridCols + (col + offset.y);
+				navGraph.edges.push_back(NavEdge_t{ (Uint16)nIndex, (Uint8)(diagonal ? 14 : 10), (Uint8)direction });
+			}
+		}
+	}
+	navGraph.offsets[gridCellCount] = navGraph.edges.size();
+	navGraph.cornerCutting = cornerCutting;
+}
+
+//***************
+// BakeClearance
+// rebuilds the clearance distance transform from gameGrid collision
+// in two passes, each taking the nearest distance from the four neighbors it has already visited
+//***************
+void BakeClearance() {
+	clearance.distances.assign(gridCellCount, 0);
+
+	for (int pass = 0; pass < 2; pass++) {
+		int step = pass == 0 ? 1 : -1;
+		int first = pass == 0 ? 0 : gridCellCount - 1;
+		for (int index = first; index >= 0 && index < gridCellCount; index += step) {
+			int row = index / gridCols;
+			int col = index % gridCols;
+			if (gameGrid.cells[row][col].solid)
+				continue;
+
+			// DEBUG: off-map neighbors count as solid
+			int nearest = (pass == 0) ? 255 : clearance.distances[index] - 1;
+			int visited[4][2] = { { -step, -1 }, { -step, 0 }, { -step, 1 }, { 0, -step } };
+			for (auto && offset : visited) {
+				int nRow = row + offset[0];
+				int nCol = col + offset[1];
+				int distance = (nRow < 0 || nRow >= gridRows || nCol < 0 || nCol >= gridCols) ? 0 : clearance.distances[nRow * gridCols + nCol];
+				if (distance < nearest)
+					nearest = distance;
+			}
+			clearance.distances[index] = (Uint8)(nearest + 1);
+		}
+	}
+}
+
+//***************
+// LabelComponents
+// flood fills the non-solid cells with connectivity labels
+// using the same navGraph steps as PathFind
+//***************
+void LabelComponents() {
+	static std::vector<GridCell_t *> frontier;
+
+	for (auto && arry : gameGrid.cells)
+		for (auto && cell : arry)
+			cell.component = -1;
+
+	components.sizes.clear();
+	components.largest = -1;
+	for (auto && arry : gameGrid.cells) {
+		for (auto && cell : arry) {
+			if (cell.solid || cell.component != -1)
+				continue;
+
+			int label = components.sizes.size();
+			int size = 0;
+			cell.component = label;
+			frontier.push_back(&cell);
+			while (!frontier.empty()) {
+				GridCell_t * current = frontier.back();
+				frontier.pop_back();
+				size++;
+
+				// DEBUG: edges only lead onto non-solid cells
+				int currentIndex = current->gridRow * gridCols + current->gridCol;
+				for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+					int nIndex = navGraph.edges[edge].cell;
+					GridCell_t & neighbor = gameGrid.cells[nIndex / gridCols][nIndex % gridCols];
+					if (neighbor.component == -1) {
+						neighbor.component = label;
+						frontier.push_back(&neighbor);
+					}
+				}
+			}
+
+			components.sizes.push_back(size);
+			if (components.largest == -1 || size > components.sizes[components.largest])
+				components.largest = label;
+		}
+	}
+}
+
+//***************
+// CellsConnected
+// true if a path exists between the cells, checked in O(1)
+//***************
+bool CellsConnected(const GridCell_t * a, const GridCell_t * b) {
+	return !a->solid && a->component == b->component;
+}
+
 //***************
 // LoadSprites
 //***************
@@ -725,8 +1590,11 @@ void ClearCellReferences(std::shared_ptr<GameObject_t> & entity) {
 	// remove the entity from any gameGrid.cells its currently in
 	for (auto && cell : entity->cells) {
 		auto index = std::find(cell->contents.cbegin(), cell->contents.cend(), entity);
-		if (index != cell->contents.end())
+		if (index != cell->contents.end()) {
 			cell->contents.erase(index);
+			if (entity->type != OBJECTTYPE_MISSILE)
+				density.counts[cell->gridRow * gridCols + cell->gridCol]--;
+		}
 	}
 
 	// empty the entity's cell references
@@ -769,6 +1637,8 @@ void UpdateCellReferences(std::shared_ptr<GameObject_t> & entity) {
 	// add the entity to any gameGrid cells its currently over
 	for (auto && cell : entity->cells) {
 		cell->contents.push_back(entity);
+		if (entity->type != OBJECTTYPE_MISSILE)
+			density.counts[cell->gridRow * gridCols + cell->gridCol]++;
 	}
 }
 
@@ -810,8 +1680,9 @@ SDL_Point GetSpawnPoint(const ObjectType_t type) {
 				break;
 			}
 
+			// DEBUG: also avoid spawning in areas walled off from most of the map
 			GridCell_t & cell = gameGrid.cells[testRow][testCol];
-			if (cell.solid || !cell.contents.empty()) {
+			if (cell.solid || !cell.contents.empty() || cell.component != components.largest) {
 				invalidSpawnPoint = true;
 				break;
 			}
@@ -906,6 +1777,10 @@ void RemoveEntity(std::shared_ptr<GameObject_t> & entity) {
 	}
 }
 
+// defined with the pathfinding functions
+void BakeNavigation();
+bool LoadFirstMoves();
+
 //***************
 // InitGame
 //***************
@@ -974,6 +1849,8 @@ bool InitGame(std::string & message) {
 		message = "Collision map";
 		return false;
 	}
+	BakeNavigation();
+	LoadFirstMoves();		// DEBUG: optional, PATHFIND_FIRST_MOVES falls back to A* without it
 
 	SpawnGoodman();
 	SpawnMonsters();
@@ -984,6 +1861,106 @@ bool InitGame(std::string & message) {
 //-------------------------------------END INITIALIZATION FUNCTIONS--------------------------------------//
 //-------------------------------------BEGIN PER-FRAME FUNCTIONS-----------------------------------------//
 
+//***************
+// CellIndex
+// flattened gameGrid index of a cell
+// used to key per-cell pathfinding data
+//***************
+int CellIndex(const GridCell_t * cell) {
+	return cell->gridRow * gridCols + cell->gridCol;
+}
+
+//***************
+// IndexToCell
+// inverse of CellIndex
+//***************
+GridCell_t * IndexToCell(const int index) {
+	return &gameGrid.cells[index / gridCols][index % gridCols];
+}
+
+//***************
+// Sign
+// returns -1, 0, or 1
+//***************
+int Sign(const int value) {
+	return (value > 0) - (value < 0);
+}
+
+//***************
+// IsWalkable
+// pathfinding utility
+// true for on-map non-solid cells
+//***************
+bool IsWalkable(const int row, const int col) {
+	return row >= 0 && row < gridRows && col >= 0 && col < gridCols && !gameGrid.cells[row][col].solid;
+}
+
+//***************
+// DirectionIndex
+// inverse of neighborOffsets
+//***************
+int DirectionIndex(const int dRow, const int dCol) {
+	int index = (dCol + 1) * 3 + (dRow + 1);
+	return index > 4 ? index - 1 : index;		// DEBUG: skip { 0, 0 }
+}
+
+//***************
+// NeighborWalkable
+// pathfinding utility
+// IsWalkable for the neighbor at dRow, dCol of a cell, read from its navGraph.walkable mask
+//***************
+bool NeighborWalkable(const int cellIndex, const int dRow, const int dCol) {
+	return (navGraph.walkable[cellIndex] >> DirectionIndex(dRow, dCol)) & 1;
+}
+
+//***************
+// UnitRadius
+// size-aware pathfinding utility
+// cells of clearance the entity's bounds need beyond the cell it is centered on
+//***************
+int UnitRadius(const GameObject_t & entity) {
+	int size = entity.bounds.w > entity.bounds.h ? entity.bounds.w : entity.bounds.h;
+	return (size + cellSize - 1) / (2 * cellSize);
+}
+
+//***************
+// PathUnitRadius
+// size-aware pathfinding utility
+// the unitRadius searches plan the entity's steps for, -1 if any navGraph step will do
+// DEBUG: navGraph steps already fit units one cell across when baked without corner cutting
+//***************
+int PathUnitRadius(const GameObject_t & entity) {
+	int unitRadius = sizeAwarePaths ? UnitRadius(entity) : -1;
+	return (unitRadius == 0 && !navGraph.cornerCutting) ? -1 : unitRadius;
+}
+
+//***************
+// BakedUnitRadius
+// size-aware pathfinding utility
+// the unitRadius jumpTable and hierarchy are baked for, the PathUnitRadius of the monsters (one cell across)
+// DEBUG: other unit sizes fall back from JPS+ to JPS, and from HPA* to A*, see PathFind
+//***************
+int BakedUnitRadius() {
+	return (sizeAwarePaths && navGraph.cornerCutting) ? 0 : -1;
+}
+
+//***************
+// UnitFits
+// size-aware pathfinding utility
+// true if a unit needing radius clearance can take the navGraph step out of cellIndex
+// diagonal steps also need the clearance at both cells beside them, so the unit never clips a corner
+// DEBUG: the cell stepped from needs none, so a unit squeezed into a tight spot can still leave
+//***************
+bool UnitFits(const int cellIndex, const NavEdge_t & step, const int radius) {
+	if (clearance.distances[step.cell] <= radius)
+		return false;
+
+	const SDL_Point & offset = neighborOffsets[step.direction];
+	if (offset.x == 0 || offset.y == 0)
+		return true;
+	return clearance.distances[cellIndex + offset.x * gridCols] > radius && clearance.distances[cellIndex + offset.y] > radius;
+}
+
 //***************
 // GetDistance
 // A* pathfinding utility
@@ -998,31 +1975,26 @@ int GetDistance(GridCell_t * start, GridCell_t * end) {
 }
 
 //***************
-// ClearSets
-// reset all the searched cells' costs
-// and set occupancy bools
-// to avoid affecting the next search
+// GetHeuristic
+// used for pathfinding
+// admissible estimate of the path cost between two cells, see heuristicMode
 //***************
-void ClearSets(std::vector<GridCell_t *> & openSet, std::vector<GridCell_t*> & closedSet) {
-	// clear the openSet
-	for (auto && cell : openSet) {
-		cell->gCost = 0;
-		cell->hCost = 0;
-		cell->fCost = 0;
-		cell->inOpenSet = false;
-		cell->parent = nullptr;
-	}
-	openSet.clear();
+int GetHeuristic(GridCell_t * start, GridCell_t * end) {
+	int estimate = GetDistance(start, end);
+	if (heuristicMode != HEURISTIC_LANDMARKS || landmarks.cells.empty())
+		return estimate;
+
+	const int * startDistances = &landmarks.distances[CellIndex(start) * landmarkCount];
+	const int * endDistances = &landmarks.distances[CellIndex(end) * landmarkCount];
+	for (size_t landmark = 0; landmark < landmarks.cells.size(); landmark++) {
+		if (startDistances[landmark] < 0 || endDistances[landmark] < 0)
+			continue;
 
-	// clear the closedSet
-	for (auto && cell : closedSet) {
-		cell->gCost = 0;
-		cell->hCost = 0;
-		cell->fCost = 0;
-		cell->inClosedSet = false;
-		cell->parent = nullptr;
+		int bound = SDL_abs(startDistances[landmark] - endDistances[landmark]);
+		if (bound > estimate)
+			estimate = bound;
 	}
-	closedSet.clear();
+	return estimate;
 }
 
 //***************
@@ -1059,554 +2031,3117 @@ GridCell_t & PointToCell(const SDL_Point & point) {
 
 
 //***************
-// PathFind
-// A* search of gameGrid cells
-// only searches static non-solid geometry
-// entities will perform dynamic collision avoidance on the fly
-// returns false if no valid path is found (also clears the current path)
-// returns true if a valid path was constructed (after clearing the current path)
+// BuildPath
+// sets path from the parents of a finished search, goal first
+// filling in any straight or diagonal runs of cells between jump points
 //***************
-bool PathFind(std::shared_ptr<GameObject_t> & entity, const SDL_Point & start, const SDL_Point & goal) {
+void BuildPath(const SearchContext_t & context, const int endIndex, Path_t & path) {
+	path.clear();
 
-	// DEBUG: static to prevent excessive dynamic allocation
-	static std::vector<GridCell_t *> openSet;
-	static std::vector<GridCell_t *> closedSet;
+	for (int index = endIndex; index != -1; index = context.parents[index]) {
+		GridCell_t * cell = IndexToCell(index);
+		path.push_back(cell);
 
-	int startRow;
-	int startCol;
-	int endRow;
-	int endCol;
-	PointToCell(start, startRow, startCol);
-	PointToCell(goal, endRow, endCol);
+		if (context.parents[index] == -1)
+			break;
 
-	GridCell_t * startCell = &gameGrid.cells[startRow][startCol];
-	GridCell_t * endCell = &gameGrid.cells[endRow][endCol];
+		GridCell_t * parentCell = IndexToCell(context.parents[index]);
+		int dRow = Sign(parentCell->gridRow - cell->gridRow);
+		int dCol = Sign(parentCell->gridCol - cell->gridCol);
+		for (int row = cell->gridRow + dRow, col = cell->gridCol + dCol; 
+			row != parentCell->gridRow || col != parentCell->gridCol; 
+			row += dRow, col += dCol) {
+			path.push_back(&gameGrid.cells[row][col]);
+		}
+	}
+}
 
-	if (endCell->solid || startCell == endCell) {
-		entity->path.clear();
-		return false;
+//***************
+// LineOfSight
+// true if the straight line between the cell centers crosses no solid cells
+// DEBUG: a line through a cell corner needs both cells beside the corner clear, 
+// so it never cuts a corner more than the original path did
+// every cell touched also needs clearance above radius, see UnitFits
+//***************
+bool LineOfSight(const GridCell_t * startCell, const GridCell_t * endCell, const int radius = 0) {
+	int row = startCell->gridRow;
+	int col = startCell->gridCol;
+	int rowDist = SDL_abs(endCell->gridRow - row);
+	int colDist = SDL_abs(endCell->gridCol - col);
+	int dRow = Sign(endCell->gridRow - row);
+	int dCol = Sign(endCell->gridCol - col);
+
+	// walk every cell the line touches (supercover), error tracks which border it crosses next
+	int error = rowDist - colDist;
+	for (int steps = rowDist + colDist; steps > 0; steps--) {
+		if (error > 0) {
+			row += dRow;
+			error -= 2 * colDist;
+		} else if (error < 0) {
+			col += dCol;
+			error += 2 * rowDist;
+		} else {
+			if (!IsWalkable(row + dRow, col) || !IsWalkable(row, col + dCol) || 
+				clearance.distances[(row + dRow) * gridCols + col] <= radius || clearance.distances[row * gridCols + col + dCol] <= radius)
+				return false;
+			row += dRow;
+			col += dCol;
+			error += 2 * (rowDist - colDist);
+			steps--;
+		}
+
+		if (!IsWalkable(row, col) || clearance.distances[row * gridCols + col] <= radius)
+			return false;
+	}
+	return true;
+}
+
+//***************
+// SmoothPath
+// string-pulls a path (goal first) in place,
+// dropping each waypoint the previous kept one can see past with radius clearance
+//***************
+void SmoothPath(Path_t & path, const int radius = 0) {
+	static thread_local Path_t smoothed;
+
+	if (path.size() <= 2)
+		return;
+
+	smoothed.clear();
+	int anchor = path.size() - 1;
+	smoothed.push_back(path[anchor]);
+	while (anchor > 0) {
+		int next = anchor - 1;
+		while (next > 0 && LineOfSight(path[anchor], path[next - 1], radius))
+			next--;
+		anchor = next;
+		smoothed.push_back(path[anchor]);
 	}
+	path.assign(smoothed.rbegin(), smoothed.rend());
+}
+
+//***************
+// AStarSearch
+// A* search of gameGrid cells from startCell to endCell
+// optionally limited to bounds, given as { row, col, rows, cols }
+// a nullptr endCell floods every reachable cell instead (Dijkstra), leaving all their gCosts in context
+// only takes the steps a unit of context.unitRadius fits through
+// leaves the resulting parents in context
+//***************
+bool AStarSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell, const SDL_Rect * bounds = nullptr) {
 	
 	// openset sort priority: first by fCost, then by hCost 
-	auto cmp = [](auto && a, auto && b) {
-		if (a->fCost > b->fCost)
-			return true;
-		else if (a->fCost == b->fCost)
-			return a->hCost > b->hCost;
-		return false;
-	};
+	context.openSet.mode = openSetMode;
 
-	// pathfinding
-	startCell->inOpenSet = true;
-	openSet.push_back(startCell);
-	while (!openSet.empty()) {
-		std::make_heap(openSet.begin(), openSet.end(), cmp);		// heapify by fCost and hCost
-		auto currentCell = openSet.front();							// copy the lowest cost cell pointer
-		openSet.erase(openSet.begin());								// remove from openSet
-		currentCell->inOpenSet = false;
-		closedSet.push_back(currentCell);							// add to closedSet using the bounds as the hashkey
-		currentCell->inClosedSet = true;
+	int startIndex = CellIndex(startCell);
+	int endIndex = endCell ? CellIndex(endCell) : -1;
+	context.gCosts[startIndex] = 0;
+	context.parents[startIndex] = -1;
+	context.openSet.Push(startIndex, 0, 0);
+	while (!context.openSet.Empty()) {
+		int currentIndex = context.openSet.Pop();		// remove the lowest cost cell from openSet
+		context.Close(currentIndex);
 
 		// check if the path is complete
-		if (currentCell == endCell) {
+		if (currentIndex == endIndex)
+			return true;
 
-			// ready the path for updating
-			entity->path.clear();
-
-			// build the path back (reverse iterator)
-			while (currentCell != nullptr) {		// FIXME: was currentCell->parent != nullptr, but that excluded the starting cell
-				entity->path.push_back(currentCell);		// TODO: instead push a flowVelocity at this index (maybe?)
-				currentCell = currentCell->parent;
+		// traverse the current cell's navGraph edges
+		// updating costs and adding to the openSet as needed 
+		// DEBUG: edges already skip offmap and solid cells, so avoid out-of-bounds, OCCUPIED, and closedSet cells, respectively
+		for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			int neighborIndex = step.cell;
+			GridCell_t * neighbor = IndexToCell(neighborIndex);
+			
+			// check for invalid neighbors
+			if ((bounds && (neighbor->gridRow < bounds->x || neighbor->gridRow >= bounds->x + bounds->w || 
+							neighbor->gridCol < bounds->y || neighbor->gridCol >= bounds->y + bounds->h)) ||
+				(context.unitRadius >= 0 && !UnitFits(currentIndex, step, context.unitRadius)) ||
+//				!EMPTY_EXCEPT_SELF(*neighbor, entity) ||
+				context.InClosedSet(neighborIndex)) {
+				continue;
 			}
 
-			// the path starts on the entity's current cell
-			entity->onPath = true;
-
-			// ensure no GridCell_t conflicts on successive path searches
-			ClearSets(openSet, closedSet);
+			// check for updated gCost or entirely new cell
+			int gCost = context.gCosts[currentIndex] + step.cost + context.congestion * density.counts[neighborIndex];
+			if (!context.openSet.Contains(neighborIndex) || gCost < context.gCosts[neighborIndex]) {
+				int hCost = endCell ? GetHeuristic(neighbor, endCell) : 0;
+				context.gCosts[neighborIndex] = gCost;
+				context.parents[neighborIndex] = currentIndex;
+				context.openSet.Push(neighborIndex, gCost + hCost, hCost);	// DEBUG: updates the key in place if already queued
+			}
+		}
+	}
+	return false;
+}
 
-			return true;
+//***************
+// BidirectionalSearch
+// A* searches from both startCell and endCell, expanding whichever frontier is smaller,
+// sets path (goal first) through the cheapest cell where they meet
+// stops once either frontier's lowest fCost reaches the cheapest meeting cost, which proves it optimal
+// only takes the steps a unit of context.unitRadius fits through, the backward side checks them reversed
+//***************
+bool BidirectionalSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell, Path_t & path) {
+	static thread_local SearchContext_t backward;		// search from endCell
+
+	int startIndex = CellIndex(startCell);
+	int endIndex = CellIndex(endCell);
+	backward.Reset();
+	context.openSet.mode = openSetMode;
+	backward.openSet.mode = openSetMode;
+	context.gCosts[startIndex] = 0;
+	context.parents[startIndex] = -1;
+	context.openSet.Push(startIndex, GetHeuristic(startCell, endCell), 0);
+	backward.gCosts[endIndex] = 0;
+	backward.parents[endIndex] = -1;
+	backward.openSet.Push(endIndex, GetHeuristic(endCell, startCell), 0);
+
+	int bestCost = INT_MAX;
+	int meetIndex = -1;
+	while (!context.openSet.Empty() && !backward.openSet.Empty()) {
+		if (meetIndex != -1 && 
+			(context.openSet.fCosts[context.openSet.Top()] >= bestCost || 
+			backward.openSet.fCosts[backward.openSet.Top()] >= bestCost)) {
+			break;
 		}
 
-		// traverse the current cell's neighbors
-		// updating costs and adding to the openSet as needed 
-		// DEBUG: avoid the cell itself, offmap cells, solid cells, OCCUPIED cells, and closedSet cells, respectively
-		for (int row = -1; row <= 1; row++) {
-			for (int col = -1; col <= 1; col++) {
-				int nRow = currentCell->gridRow + row;
-				int nCol = currentCell->gridCol + col;
-				
-				// check for invalid neighbors
-				if ((row == 0 && col == 0) ||
-					(nRow < 0 || nRow >= gridRows || nCol < 0 || nCol >= gridCols) ||
-					gameGrid.cells[nRow][nCol].solid ||
-//					!EMPTY_EXCEPT_SELF(gameGrid.cells[nRow][nCol], entity) ||
-					gameGrid.cells[nRow][nCol].inClosedSet) {
-					continue;
-				}
+		bool forward = context.openSet.count <= backward.openSet.count;
+		SearchContext_t & side = forward ? context : backward;
+		SearchContext_t & other = forward ? backward : context;
+		GridCell_t * target = forward ? endCell : startCell;
+
+		int currentIndex = side.openSet.Pop();
+		side.Close(currentIndex);
+
+		// DEBUG: navGraph steps between non-solid cells are the same both ways,
+		// and a solid startCell is always expanded first (by the forward side), so the frontiers still meet
+		for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			int neighborIndex = step.cell;
+			if (side.InClosedSet(neighborIndex))
+				continue;
+
+			if (context.unitRadius >= 0 && 
+				!(forward ? UnitFits(currentIndex, step, context.unitRadius) 
+						  : UnitFits(neighborIndex, NavEdge_t{ (Uint16)currentIndex, step.cost, (Uint8)(7 - step.direction) }, context.unitRadius))) {
+				continue;
+			}
 
-				// check for updated gCost or entirely new cell
-				GridCell_t * neighbor = &gameGrid.cells[nRow][nCol];
-				int gCost = currentCell->gCost + GetDistance(currentCell, neighbor);
-				if (gCost < neighbor->gCost || !neighbor->inOpenSet) {
-					neighbor->gCost = gCost;
-					neighbor->hCost = GetDistance(neighbor, endCell);
-					neighbor->fCost = gCost + neighbor->hCost;
-					neighbor->parent = currentCell;
-
-					if (!neighbor->inOpenSet) {
-						openSet.push_back(neighbor);
-						neighbor->inOpenSet = true;
-					}
+			GridCell_t * neighbor = IndexToCell(neighborIndex);
+			int gCost = side.gCosts[currentIndex] + step.cost;
+			if (!side.openSet.Contains(neighborIndex) || gCost < side.gCosts[neighborIndex]) {
+				int hCost = GetHeuristic(neighbor, target);
+				side.gCosts[neighborIndex] = gCost;
+				side.parents[neighborIndex] = currentIndex;
+				side.openSet.Push(neighborIndex, gCost + hCost, hCost);
+
+				// the frontiers touch
+				if ((other.InClosedSet(neighborIndex) || other.openSet.Contains(neighborIndex)) && 
+					gCost + other.gCosts[neighborIndex] < bestCost) {
+					bestCost = gCost + other.gCosts[neighborIndex];
+					meetIndex = neighborIndex;
 				}
 			}
 		}
 	}
-	// ensure no GridCell_t conflicts on successive path searches
-	ClearSets(openSet, closedSet);
+	context.expansions += backward.expansions;
 
-	entity->path.clear();
-	return false;		// DEBUG: this will be hit if an entity is surrounded by entities on its first search
+	if (meetIndex == -1)
+		return false;
+
+	// endCell back to the meeting cell, then the meeting cell back to startCell
+	path.clear();
+	for (int index = backward.parents[meetIndex]; index != -1; index = backward.parents[index])
+		path.push_back(IndexToCell(index));
+	path.reverse();
+	for (int index = meetIndex; index != -1; index = context.parents[index])
+		path.push_back(IndexToCell(index));
+	return true;
 }
 
 //***************
-// UpdateBob
-// used for animation
+// CellFits
+// jump point search utility
+// true if a unit of radius fits centered on row, col, see UnitFits
+// radius -1 only needs the cell on the map and non-solid
 //***************
-void UpdateBob(std::shared_ptr<GameObject_t> & entity, const Vec2_t & move) {
-	if (entity->health > 0) {
-		bool continueBob = (move.x || move.y);
-		if (continueBob && !entity->bobMaxed) {
-			entity->bobMaxed = (++entity->bob >= 5) ? true : false;
-			entity->origin.y--;
-		} else if (entity->bob > 0) {
-			entity->bobMaxed = (--entity->bob > 0) ? true : false;
-			entity->origin.y++;
-		}
-	}
+bool CellFits(const int row, const int col, const int radius) {
+	if (radius < 0)
+		return IsWalkable(row, col);
+	return row >= 0 && row < gridRows && col >= 0 && col < gridCols && clearance.distances[row * gridCols + col] > radius;
 }
 
 //***************
-// CheckWaypointRange
-// used for dynamic pathfinding
-// DEBUG: never call with entity->path.empty()
+// JumpsCutCorners
+// jump point search utility
+// true if the jumps of a unit of radius may take diagonal steps past a solid cell beside them
+// DEBUG: UnitFits never does, so size-aware jumps use the rules without corner cutting
 //***************
-bool CheckWaypointRange(std::shared_ptr<GameObject_t> & entity) {
-	int xRange = SDL_abs((int)(entity->center.x - entity->path.back()->center.x));
-	int yRange = SDL_abs((int)(entity->center.y - entity->path.back()->center.y));
-	return (xRange <= entity->speed && yRange <= entity->speed);
+bool JumpsCutCorners(const int radius) {
+	return radius < 0 && navGraph.cornerCutting;
 }
 
 //***************
-// Normalize
-// used for dynamic pathfinding
+// StepFits
+// jump point search utility
+// true if a unit of radius can take the step along dRow, dCol out of row, col, see UnitFits
+// radius -1 takes any navGraph step
 //***************
-void Normalize(Vec2_t & v) {
-	float length = SDL_sqrtf(v.x * v.x + v.y * v.y);
-	if (length) {
-		float invLength = 1.0f / length;
-		v.x *= invLength;
-		v.y *= invLength;
-	}
+bool StepFits(const int row, const int col, const int dRow, const int dCol, const int radius) {
+	if (JumpsCutCorners(radius))
+		return NeighborWalkable(row * gridCols + col, dRow, dCol);
+	return CellFits(row + dRow, col + dCol, radius) && 
+			(dRow == 0 || dCol == 0 || (CellFits(row + dRow, col, radius) && CellFits(row, col + dCol, radius)));
 }
 
 //***************
-// UpdateOrigin
+// HasForcedNeighbor
+// jump point search utility
+// true if arriving at row, col while moving along dRow, dCol 
+// exposes a neighbor only reachable optimally through row, col
+// without corner cutting only straight moves have forced neighbors, beside cells just past a wall
 //***************
-void UpdateOrigin(std::shared_ptr<GameObject_t>  & entity, const Vec2_t & move) {
-	int dx = (int)nearbyintf(move.x);
-	int dy = (int)nearbyintf(move.y);
+bool HasForcedNeighbor(const int row, const int col, const int dRow, const int dCol, const int radius = -1) {
+	if (!JumpsCutCorners(radius)) {
+		if (dRow != 0 && dCol != 0)
+			return false;
+		else if (dRow != 0)
+			return (CellFits(row, col + 1, radius) && !CellFits(row - dRow, col + 1, radius)) ||
+					(CellFits(row, col - 1, radius) && !CellFits(row - dRow, col - 1, radius));
+		return (CellFits(row + 1, col, radius) && !CellFits(row + 1, col - dCol, radius)) ||
+				(CellFits(row - 1, col, radius) && !CellFits(row - 1, col - dCol, radius));
+	}
 
-	entity->origin.x += dx;
-	entity->origin.y += dy;
-	entity->bounds.x += dx;
-	entity->bounds.y += dy;
-	entity->center.x += nearbyintf(move.x);
-	entity->center.y += nearbyintf(move.y);
-	int derp = 0;
+	int index = row * gridCols + col;
+	if (dRow != 0 && dCol != 0) {
+		return (!NeighborWalkable(index, -dRow, 0) && NeighborWalkable(index, -dRow, dCol)) ||
+				(!NeighborWalkable(index, 0, -dCol) && NeighborWalkable(index, dRow, -dCol));
+	} else if (dRow != 0) {
+		return (!NeighborWalkable(index, 0, 1) && NeighborWalkable(index, dRow, 1)) ||
+				(!NeighborWalkable(index, 0, -1) && NeighborWalkable(index, dRow, -1));
+	}
+	return (!NeighborWalkable(index, 1, 0) && NeighborWalkable(index, 1, dCol)) ||
+			(!NeighborWalkable(index, -1, 0) && NeighborWalkable(index, -1, dCol));
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////
-// BEGIN FREEHILL flocking test
-/*
 //***************
-// GetGroupAlignment
-// flocking utility
-// calculates the normalized average group velocity
-// TODO(?): weighted average
+// Jump
+// jump point search utility
+// steps from row, col along dRow, dCol until reaching endCell, a forced neighbor, or a wall
+// only takes the steps a unit of radius fits through, see StepFits
+// returns the CellIndex of the jump point, or -1 if there is none
 //***************
-void GetGroupAlignment(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
-	result = vec2zero;
-	if (!areaContents.size())
-		return;
-
-	float groupCount = 0.0f;
-	for (auto && entity : areaContents) {
-		if (entity->groupID == self->groupID) {
-			result.x += entity->velocity.x;
-			result.y += entity->velocity.y;
-			groupCount++;
+int Jump(int row, int col, const int dRow, const int dCol, const GridCell_t * endCell, const int radius = -1) {
+	while (true) {
+		if (!StepFits(row, col, dRow, dCol, radius))
+			return -1;
+		row += dRow;
+		col += dCol;
+
+		if ((row == endCell->gridRow && col == endCell->gridCol) || HasForcedNeighbor(row, col, dRow, dCol, radius))
+			return row * gridCols + col;
+
+		// diagonal moves stop where either straight component finds a jump point
+		if (dRow != 0 && dCol != 0) {
+			if (Jump(row, col, dRow, 0, endCell, radius) != -1 || Jump(row, col, 0, dCol, endCell, radius) != -1)
+				return row * gridCols + col;
 		}
 	}
-
-	if (!groupCount)
-		return;
-
-	result.x /= groupCount;
-	result.y /= groupCount;
-	Normalize(result);
 }
+
 //***************
-// GetGroupCohesion
-// flocking utility
-// calulates the average group center
-// then a normalized vector towards that center
+// GetJumpDirections
+// jump point search utility
+// fills directions with the pruned travel directions out of a closed cell
+// the start cell has no travel direction, so gets all of them
+// returns the number of directions
 //***************
-void GetGroupCohesion(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
-	result = vec2zero;
-	if (!areaContents.size())
-		return;
+int GetJumpDirections(const SearchContext_t & context, const int cellIndex, SDL_Point (&directions)[8]) {
+	int directionCount = 0;
+	if (context.parents[cellIndex] == -1) {
+		for (int direction = 0; direction < 8; direction++)
+			directions[directionCount++] = neighborOffsets[direction];
+		return directionCount;
+	}
 
-	float groupCount = 0.0f;
-	for (auto && entity : areaContents) {
-		if (entity->groupID == self->groupID) {
-			result.x += entity->center.x;
-			result.y += entity->center.y;
-			groupCount++;
+	GridCell_t * cell = IndexToCell(cellIndex);
+	GridCell_t * parentCell = IndexToCell(context.parents[cellIndex]);
+	int row = cell->gridRow;
+	int col = cell->gridCol;
+	int dRow = Sign(row - parentCell->gridRow);
+	int dCol = Sign(col - parentCell->gridCol);
+
+	// without corner cutting a wall just passed exposes the cell beside it, and the diagonal past it
+	int radius = context.unitRadius;
+	if (!JumpsCutCorners(radius)) {
+		directions[directionCount++] = { dRow, dCol };
+		if (dRow != 0 && dCol != 0) {
+			directions[directionCount++] = { dRow, 0 };
+			directions[directionCount++] = { 0, dCol };
+		} else {
+			for (int side = -1; side <= 1; side += 2) {
+				SDL_Point beside = dRow != 0 ? SDL_Point{ 0, side } : SDL_Point{ side, 0 };
+				if (CellFits(row + beside.x, col + beside.y, radius) && !CellFits(row + beside.x - dRow, col + beside.y - dCol, radius)) {
+					directions[directionCount++] = beside;
+					directions[directionCount++] = { dRow + beside.x, dCol + beside.y };
+				}
+			}
 		}
+		return directionCount;
 	}
 
-	if (!groupCount)
-		return;
-
-	result.x /= groupCount;
-	result.y /= groupCount;
-	result = { result.x - self->center.x, result.y - self->center.y };
-	Normalize(result);
+	if (dRow != 0 && dCol != 0) {
+		directions[directionCount++] = { dRow, dCol };
+		directions[directionCount++] = { dRow, 0 };
+		directions[directionCount++] = { 0, dCol };
+		if (!NeighborWalkable(cellIndex, -dRow, 0))
+			directions[directionCount++] = { -dRow, dCol };
+		if (!NeighborWalkable(cellIndex, 0, -dCol))
+			directions[directionCount++] = { dRow, -dCol };
+	} else if (dRow != 0) {
+		directions[directionCount++] = { dRow, 0 };
+		if (!NeighborWalkable(cellIndex, 0, 1))
+			directions[directionCount++] = { dRow, 1 };
+		if (!NeighborWalkable(cellIndex, 0, -1))
+			directions[directionCount++] = { dRow, -1 };
+	} else {
+		directions[directionCount++] = { 0, dCol };
+		if (!NeighborWalkable(cellIndex, 1, 0))
+			directions[directionCount++] = { 1, dCol };
+		if (!NeighborWalkable(cellIndex, -1, 0))
+			directions[directionCount++] = { -1, dCol };
+	}
+	return directionCount;
 }
 
 //***************
-// GetGroupSeparation
-// flocking utility
-// calculates the average separation from group members
-// TODO(?): wieghted average
+// JumpPointSearch
+// A* search of gameGrid jump points from startCell to endCell
+// prunes neighbors that have an equally short route not passing through the current cell
+// only takes the steps a unit of context.unitRadius fits through
+// leaves the resulting parents in context, see BuildPath
 //***************
-void GetGroupSeparation(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
-	result = vec2zero;
-	if (!areaContents.size())
-		return;
+bool JumpPointSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell) {
 
-	float groupCount = 0.0f;
-	for (auto && entity : areaContents) {
-		if (entity->groupID == self->groupID) {
-			// FIXME: weigh this based on bounding box size,
-			// not just center-to-center range.
-			result.x += (entity->center.x - self->center.x);
-			result.y += (entity->center.y - self->center.y);
-			groupCount++;
+	// openset sort priority: first by fCost, then by hCost 
+	context.openSet.mode = openSetMode;
+
+	int startIndex = CellIndex(startCell);
+	int endIndex = CellIndex(endCell);
+	context.gCosts[startIndex] = 0;
+	context.parents[startIndex] = -1;
+	context.openSet.Push(startIndex, 0, 0);
+	while (!context.openSet.Empty()) {
+		int currentIndex = context.openSet.Pop();
+		context.Close(currentIndex);
+		GridCell_t * currentCell = IndexToCell(currentIndex);
+
+		if (currentIndex == endIndex)
+			return true;
+
+		// jump along each pruned direction, updating costs and adding jump points to the openSet as needed
+		SDL_Point directions[8];
+		int directionCount = GetJumpDirections(context, currentIndex, directions);
+		for (int direction = 0; direction < directionCount; direction++) {
+			int jumpIndex = Jump(currentCell->gridRow, currentCell->gridCol, directions[direction].x, directions[direction].y, endCell, context.unitRadius);
+			if (jumpIndex == -1 || context.InClosedSet(jumpIndex))
+				continue;
+
+			GridCell_t * jumpCell = IndexToCell(jumpIndex);
+			int gCost = context.gCosts[currentIndex] + GetDistance(currentCell, jumpCell);
+			if (!context.openSet.Contains(jumpIndex) || gCost < context.gCosts[jumpIndex]) {
+				int hCost = GetHeuristic(jumpCell, endCell);
+				context.gCosts[jumpIndex] = gCost;
+				context.parents[jumpIndex] = currentIndex;
+				context.openSet.Push(jumpIndex, gCost + hCost, hCost);
+			}
 		}
 	}
-
-	if (!groupCount)
-		return;
-
-	result.x /= -groupCount;
-	result.y /= -groupCount;
-	Normalize(result);
+	return false;
 }
-*/
-// END FREEHILL flocking test
-///////////////////////////////////////////////////////////////////////////////////////////////
 
-//******************
-// Rotate
-// expanded and factored version of:
-// (rotationQuaternion) * quaternionVector( targetX, targetY, 0.0f, 0.0f ) * (rotationQuaternion)^-1
-// assumes a right-handed coordinate system
-// if clockwise == false, it rotates the target values counter-clockwise
-// --only deals with unit length quaternions--
-//******************
-void Rotate(bool clockwise, Vec2_t & result) {
-	static const float ccw[]	= { 0.0f, 0.0f, SDL_sinf(DEG2RAD(1.0f) / 2.0f), SDL_cosf(DEG2RAD(1.0f) / 2.0f) };
-	static const float cw[]		= { 0.0f, 0.0f, SDL_sinf(DEG2RAD(-1.0f) / 2.0f), SDL_cosf(DEG2RAD(-1.0f) / 2.0f) };
+//***************
+// BakeJumpTable
+// precomputes the goal-independent jump distances of every cell for JPS+
+// for the steps a unit of unitRadius fits through, see StepFits
+// straight directions first, because diagonal jumps stop where a straight jump finds a jump point
+//***************
+void BakeJumpTable(const int unitRadius) {
+	static const int straight[] = { 1, 3, 4, 6 };
+	static const int diagonal[] = { 0, 2, 5, 7 };
+
+	jumpTable.distances.assign(gridCellCount, std::array<Sint16, 8>());
+	jumpTable.unitRadius = unitRadius;
+	for (int pass = 0; pass < 2; pass++) {
+		const int * directions = pass == 0 ? straight : diagonal;
+
+		for (int index = 0; index < gridCellCount; index++) {
+			GridCell_t * cell = IndexToCell(index);
+			if (cell->solid)
+				continue;
+
+			for (int direction = 0; direction < 4; direction++) {
+				const SDL_Point & offset = neighborOffsets[directions[direction]];
+				int row = cell->gridRow;
+				int col = cell->gridCol;
+				int steps = 0;
+				int distance = 0;
+
+				while (true) {
+					if (!StepFits(row, col, offset.x, offset.y, unitRadius)) {
+						distance = -steps;
+						break;
+					}
+					row += offset.x;
+					col += offset.y;
+					steps++;
+
+					bool jumpPoint = HasForcedNeighbor(row, col, offset.x, offset.y, unitRadius);
+					if (!jumpPoint && pass == 1) {
+						auto & straightDistances = jumpTable.distances[row * gridCols + col];
+						jumpPoint = straightDistances[DirectionIndex(offset.x, 0)] > 0 || straightDistances[DirectionIndex(0, offset.y)] > 0;
+					}
 
-	const float * r;
-	if (clockwise)
-		r = cw;
-	else
-		r = ccw;
+					if (jumpPoint) {
+						distance = steps;
+						break;
+					}
+				}
+				jumpTable.distances[index][directions[direction]] = (Sint16)distance;
+			}
+		}
+	}
+}
 
-	float xxzz = r[0]*r[0] - r[2]*r[2];
-	float wwyy = r[3]*r[3] - r[1]*r[1];
+//***************
+// JumpPointPlusSearch
+// jump point search that reads each jump from jumpTable instead of scanning the grid
+// adds a target jump point wherever a jump passes endCell, or lines up with it diagonally
+// DEBUG: jumpTable must be baked for context.unitRadius
+// leaves the resulting parents in context, see BuildPath
+//***************
+bool JumpPointPlusSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell) {
 
-	float xy2 = r[0]*r[1]*2.0f;
-	float zw2 = r[2]*r[3]*2.0f;
+	// openset sort priority: first by fCost, then by hCost 
+	context.openSet.mode = openSetMode;
+
+	int startIndex = CellIndex(startCell);
+	int endIndex = CellIndex(endCell);
+	context.gCosts[startIndex] = 0;
+	context.parents[startIndex] = -1;
+	context.openSet.Push(startIndex, 0, 0);
+	while (!context.openSet.Empty()) {
+		int currentIndex = context.openSet.Pop();
+		context.Close(currentIndex);
+		GridCell_t * currentCell = IndexToCell(currentIndex);
+
+		if (currentIndex == endIndex)
+			return true;
 
-	float oldX = result.x;
-	float oldY = result.y;
+		int row = currentCell->gridRow;
+		int col = currentCell->gridCol;
+		SDL_Point directions[8];
+		int directionCount = GetJumpDirections(context, currentIndex, directions);
+		for (int direction = 0; direction < directionCount; direction++) {
+			int dRow = directions[direction].x;
+			int dCol = directions[direction].y;
+			int distance = jumpTable.distances[currentIndex][DirectionIndex(dRow, dCol)];
+
+			// steps along this direction to line up with (or reach) endCell, if it lies ahead
+			int rowsToGoal = (endCell->gridRow - row) * dRow;
+			int colsToGoal = (endCell->gridCol - col) * dCol;
+			int goalSteps = 0;
+			if (dRow != 0 && dCol != 0) {
+				if (rowsToGoal > 0 && colsToGoal > 0)
+					goalSteps = rowsToGoal < colsToGoal ? rowsToGoal : colsToGoal;
+			} else if (dRow != 0) {
+				if (endCell->gridCol == col && rowsToGoal > 0)
+					goalSteps = rowsToGoal;
+			} else if (endCell->gridRow == row && colsToGoal > 0) {
+				goalSteps = colsToGoal;
+			}
 
-	result = {	(xxzz + wwyy)*oldX + (xy2 - zw2)*oldY,
-				(xy2 + zw2)*oldX + (r[1]*r[1] + r[3]*r[3] - r[0]*r[0] - r[2]*r[2])*oldY };
+			int steps;
+			if (goalSteps > 0 && goalSteps <= SDL_abs(distance))
+				steps = goalSteps;
+			else if (distance > 0)
+				steps = distance;
+			else
+				continue;
+
+			int jumpIndex = (row + dRow * steps) * gridCols + (col + dCol * steps);
+			if (context.InClosedSet(jumpIndex))
+				continue;
+
+			GridCell_t * jumpCell = IndexToCell(jumpIndex);
+			int gCost = context.gCosts[currentIndex] + GetDistance(currentCell, jumpCell);
+			if (!context.openSet.Contains(jumpIndex) || gCost < context.gCosts[jumpIndex]) {
+				int hCost = GetHeuristic(jumpCell, endCell);
+				context.gCosts[jumpIndex] = gCost;
+				context.parents[jumpIndex] = currentIndex;
+				context.openSet.Push(jumpIndex, gCost + hCost, hCost);
+			}
+		}
+	}
+	return false;
 }
 
 //***************
-// Maximize
+// ClusterOf
+// HPA* utility
+// index of the cluster containing the cell
 //***************
-float Maximize(const float & a, const float & b) {
-	return a > b ? a : b;
+int ClusterOf(const GridCell_t * cell) {
+	return (cell->gridRow / clusterSize) * clusterCols + (cell->gridCol / clusterSize);
 }
 
 //***************
-// Minimize
+// ClusterBounds
+// HPA* utility
+// cluster cells as { row, col, rows, cols }
 //***************
-float Minimize(const float & a, const float & b) {
-	return a < b ? a : b;
+SDL_Rect ClusterBounds(const int cluster) {
+	int row = (cluster / clusterCols) * clusterSize;
+	int col = (cluster % clusterCols) * clusterSize;
+	return SDL_Rect{ row, col, SDL_min(clusterSize, gridRows - row), SDL_min(clusterSize, gridCols - col) };
 }
 
 //***************
-// GetSurfaceNormal
-// DEBUG: disregards collision
+// LinkBorder
+// HPA* utility
+// replaces the entrances paired across the border between two neighboring clusters
+// each open run of border cells gets one entrance pair in its middle, or one at each end if long
 //***************
-Vec2_t GetSurfaceNormal(const SDL_Rect & a, const SDL_Rect & b, const Vec2_t & va, const Vec2_t & vb) {
-	Vec2_t normal = vec2zero;
-	Vec2_t aMin = { (float)a.x, (float)a.y };
-	Vec2_t aMax = { (float)(a.x + a.w), (float)(a.y + a.h) };
-	Vec2_t bMin = { (float)b.x, (float)b.y };
-	Vec2_t bMax = { (float)(b.x + b.w), (float)(b.y + b.h) };
-	Vec2_t relativeV = va - vb;
-
-	for (int i = 0; i < 2; i++) {
-		if (relativeV[i] <= 0.0f) {
-//			if (aMax[i] < bMin[i]) /* does nothing, yet */;
-			if (bMax[i] <= aMin[i]) normal[i] = 1.0f;
-//			if (aMax[i] > bMin[i])	/* does nothing, yet */;
+void LinkBorder(int first, int second) {
+	if (first > second)
+		std::swap(first, second);
+
+	// drop the old pairs
+	for (int pass = 0; pass < 2; pass++) {
+		int cluster = pass == 0 ? first : second;
+		int other = pass == 0 ? second : first;
+		for (auto && entrance : hierarchy.entrances[cluster]) {
+			auto & edges = hierarchy.interEdges[entrance];
+			edges.erase(std::remove_if(edges.begin(), edges.end(), [other](auto && edge) { return ClusterOf(IndexToCell(edge.cell)) == other; }), edges.end());
 		}
-		if (relativeV[i] > 0.0f) {
-//			if (aMin[i] > bMax[i]) /* does nothing, yet */;
-			if (aMax[i] <= bMin[i]) normal[i] = -1.0f;
-//			if (bMax[i] > aMin[i]) /* does nothing, yet */;
+	}
+
+	// second is either the next cluster along the columns, or along the rows
+	SDL_Rect bounds = ClusterBounds(first);
+	bool alongCols = (second == first + 1);
+	int length = alongCols ? bounds.w : bounds.h;
+	int runStart = -1;
+	for (int step = 0; step <= length; step++) {
+		int row = alongCols ? bounds.x + step : bounds.x + bounds.w - 1;
+		int col = alongCols ? bounds.y + bounds.h - 1 : bounds.y + step;
+		int nextRow = alongCols ? row : row + 1;
+		int nextCol = alongCols ? col + 1 : col;
+		bool open = step < length && CellFits(row, col, hierarchy.unitRadius) && CellFits(nextRow, nextCol, hierarchy.unitRadius);
+
+		if (open && runStart == -1) {
+			runStart = step;
+		} else if (!open && runStart != -1) {
+			int runEnd = step - 1;
+			int pairs[2] = { (runStart + runEnd) / 2, -1 };
+			if (runEnd - runStart + 1 >= 6) {
+				pairs[0] = runStart;
+				pairs[1] = runEnd;
+			}
+
+			for (auto && pair : pairs) {
+				if (pair == -1)
+					continue;
+
+				int a = alongCols ? (bounds.x + pair) * gridCols + col : row * gridCols + (bounds.y + pair);
+				int b = alongCols ? a + 1 : a + gridCols;
+				hierarchy.interEdges[a].push_back(ClusterEdge_t{ b, 10 });
+				hierarchy.interEdges[b].push_back(ClusterEdge_t{ a, 10 });
+			}
+			runStart = -1;
 		}
 	}
-	return normal;
 }
 
 //***************
-// TranslateRect
-// dynamic pathfinding utility
+// LinkEntrances
+// HPA* utility
+// collects the cluster's entrances
+// and links each pair that can reach each other without leaving the cluster
 //***************
-SDL_Rect TranslateRect(const SDL_Rect & src, const Vec2_t translation) {
-	return SDL_Rect {	(int)nearbyintf(src.x + translation.x), 
-						(int)nearbyintf(src.y + translation.y), 
-						src.w, 
-						src.h };
+void LinkEntrances(const int cluster) {
+	SDL_Rect bounds = ClusterBounds(cluster);
+	auto & entrances = hierarchy.entrances[cluster];
+
+	entrances.clear();
+	for (int row = bounds.x; row < bounds.x + bounds.w; row++) {
+		for (int col = bounds.y; col < bounds.y + bounds.h; col++) {
+			int index = row * gridCols + col;
+			hierarchy.intraEdges[index].clear();
+			if (!hierarchy.interEdges[index].empty())
+				entrances.push_back(index);
+		}
+	}
+
+	for (auto && entrance : entrances) {
+		mainSearchContext.Reset();
+		mainSearchContext.unitRadius = hierarchy.unitRadius;
+		AStarSearch(mainSearchContext, IndexToCell(entrance), nullptr, &bounds);
+		for (auto && other : entrances) {
+			if (other != entrance && mainSearchContext.InClosedSet(other))
+				hierarchy.intraEdges[entrance].push_back(ClusterEdge_t{ other, mainSearchContext.gCosts[other] });
+		}
+	}
 }
 
+//***************
+// BuildHierarchy
+// builds the whole HPA* abstract graph
+// from the steps a unit of unitRadius fits through, see UnitFits
+//***************
+void BuildHierarchy(const int unitRadius) {
+	hierarchy.unitRadius = unitRadius;
+	hierarchy.intraEdges.assign(gridCellCount, std::vector<ClusterEdge_t>());
+	hierarchy.interEdges.assign(gridCellCount, std::vector<ClusterEdge_t>());
+	for (auto && entrances : hierarchy.entrances)
+		entrances.clear();
+
+	for (int cluster = 0; cluster < clusterCount; cluster++) {
+		if (cluster % clusterCols < clusterCols - 1)
+			LinkBorder(cluster, cluster + 1);
+		if (cluster / clusterCols < clusterRows - 1)
+			LinkBorder(cluster, cluster + clusterCols);
+	}
+
+	for (int cluster = 0; cluster < clusterCount; cluster++)
+		LinkEntrances(cluster);
+}
 
 //***************
-// BroadPhaseAABB
-// dynamic pathfinding utility
-// Broad-phase moving AABB-AABB collision test utility
+// RebuildCluster
+// incrementally updates the HPA* abstract graph after the cluster's solid cells change
+// only its borders, and the entrance links of it and its neighbors, are redone
 //***************
-SDL_Rect GetBroadPhaseAABB(std::shared_ptr<GameObject_t> & entity) {
-	SDL_Rect bpAABB;
-	Vec2_t sweep = entity->velocity * entity->speed;
-	bpAABB.x = entity->velocity.x > 0.0f ? entity->bounds.x : (int)nearbyintf(entity->bounds.x + sweep.x);
-	bpAABB.y = entity->velocity.y > 0.0f ? entity->bounds.y : (int)nearbyintf(entity->bounds.y + sweep.y);
-	bpAABB.w = entity->velocity.x > 0.0f ? (int)nearbyintf(entity->bounds.w + sweep.x) : (int)nearbyintf(entity->bounds.w - sweep.x);
-	bpAABB.h = entity->velocity.y > 0.0f ? (int)nearbyintf(entity->bounds.h + sweep.y) : (int)nearbyintf(entity->bounds.h - sweep.y);
-	return bpAABB;
+void RebuildCluster(const int cluster) {
+	int neighbors[4];
+	int neighborCount = 0;
+	if (cluster % clusterCols > 0)
+		neighbors[neighborCount++] = cluster - 1;
+	if (cluster % clusterCols < clusterCols - 1)
+		neighbors[neighborCount++] = cluster + 1;
+	if (cluster / clusterCols > 0)
+		neighbors[neighborCount++] = cluster - clusterCols;
+	if (cluster / clusterCols < clusterRows - 1)
+		neighbors[neighborCount++] = cluster + clusterCols;
+
+	for (int neighbor = 0; neighbor < neighborCount; neighbor++)
+		LinkBorder(cluster, neighbors[neighbor]);
+
+	LinkEntrances(cluster);
+	for (int neighbor = 0; neighbor < neighborCount; neighbor++)
+		LinkEntrances(neighbors[neighbor]);
 }
 
 //***************
-// AABBAABBTest
-// dynamic pathfinding utility
-// AABB-AABB collision test
-// DEBUG: includes touching
-// returns true in the case of intersection
+// HierarchicalSearch
+// HPA* search, sets path (goal first) directly
+// searches the abstract graph of cluster entrances with startCell and endCell temporarily linked in,
+// then refines each abstract edge with an A* search confined to its cluster
+// falls back to AStarSearch for short searches, or routes the abstract graph misses 
+// (such as diagonal-only border crossings)
+// DEBUG: hierarchy must be built for context.unitRadius
 //***************
-bool AABBAABBTest(const SDL_Rect & a, const SDL_Rect & b) {
-	int t;
-	// if((t = a.x - b.x) == b.w || -t == a.w) return true; (confirms touching in x)
-	// if((t = a.y - b.y) == b.h || -t == a.h) return true; (confirms touching in y)
+bool HierarchicalSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell, Path_t & path) {
+	static thread_local std::vector<ClusterEdge_t> startEdges;
+	static thread_local std::vector<ClusterEdge_t> endEdges;
+	static thread_local std::vector<int> waypoints;
+	static thread_local Path_t segment;
 
-	if ((t = a.x - b.x) > b.w || -t > a.w) return false;
-	if ((t = a.y - b.y) > b.h || -t > a.h) return false;
+	int unitRadius = context.unitRadius;
+
+	int startCluster = ClusterOf(startCell);
+	int endCluster = ClusterOf(endCell);
+	int startIndex = CellIndex(startCell);
+	int endIndex = CellIndex(endCell);
+
+	if (startCluster == endCluster || hierarchy.interEdges.empty()) {
+		if (!AStarSearch(context, startCell, endCell))
+			return false;
+		BuildPath(context, endIndex, path);
+		return true;
+	}
+
+	// link startCell and endCell to the entrances of their own clusters
+	int expansions = 0;
+	for (int pass = 0; pass < 2; pass++) {
+		GridCell_t * cell = pass == 0 ? startCell : endCell;
+		auto & edges = pass == 0 ? startEdges : endEdges;
+		SDL_Rect bounds = ClusterBounds(pass == 0 ? startCluster : endCluster);
+
+		edges.clear();
+		context.Reset();
+		context.unitRadius = unitRadius;
+		AStarSearch(context, cell, nullptr, &bounds);
+		expansions += context.expansions;
+		for (auto && entrance : hierarchy.entrances[pass == 0 ? startCluster : endCluster]) {
+			if (context.InClosedSet(entrance))
+				edges.push_back(ClusterEdge_t{ entrance, context.gCosts[entrance] });
+		}
+	}
+
+	// abstract search
+	bool found = false;
+	context.Reset();
+	context.openSet.mode = openSetMode;
+	context.gCosts[startIndex] = 0;
+	context.parents[startIndex] = -1;
+	context.openSet.Push(startIndex, 0, 0);
+	while (!context.openSet.Empty()) {
+		int currentIndex = context.openSet.Pop();
+		context.Close(currentIndex);
+		if (currentIndex == endIndex) {
+			found = true;
+			break;
+		}
+
+		GridCell_t * currentCell = IndexToCell(currentIndex);
+		for (int edgeList = 0; edgeList < 3; edgeList++) {
+			const std::vector<ClusterEdge_t> * edges;
+			switch (edgeList) {
+				case 0: edges = (currentIndex == startIndex) ? &startEdges : &hierarchy.intraEdges[currentIndex]; break;
+				case 1: edges = &hierarchy.interEdges[currentIndex]; break;
+				default: edges = (ClusterOf(currentCell) == endCluster) ? &endEdges : nullptr; break;
+			}
+			if (edges == nullptr)
+				continue;
+
+			for (auto && edge : *edges) {
+				// endEdges run from endCell, so read them backwards (costs are symmetric)
+				int nextIndex = (edgeList == 2) ? endIndex : edge.cell;
+				if (edgeList == 2 && edge.cell != currentIndex)
+					continue;
+				if (context.InClosedSet(nextIndex))
+					continue;
+
+				int gCost = context.gCosts[currentIndex] + edge.cost;
+				if (!context.openSet.Contains(nextIndex) || gCost < context.gCosts[nextIndex]) {
+					int hCost = GetHeuristic(IndexToCell(nextIndex), endCell);
+					context.gCosts[nextIndex] = gCost;
+					context.parents[nextIndex] = currentIndex;
+					context.openSet.Push(nextIndex, gCost + hCost, hCost);
+				}
+			}
+		}
+	}
+	expansions += context.expansions;
+
+	if (!found) {
+		context.Reset();
+		context.unitRadius = unitRadius;
+		if (!AStarSearch(context, startCell, endCell))
+			return false;
+		BuildPath(context, endIndex, path);
+		context.expansions += expansions;
+		return true;
+	}
+
+	// refine each abstract edge, working back from the goal
+	waypoints.clear();
+	for (int index = endIndex; index != -1; index = context.parents[index])
+		waypoints.push_back(index);
+
+	path.clear();
+	path.push_back(endCell);
+	for (size_t waypoint = 1; waypoint < waypoints.size(); waypoint++) {
+		GridCell_t * from = IndexToCell(waypoints[waypoint]);
+		GridCell_t * to = IndexToCell(waypoints[waypoint - 1]);
+		if (ClusterOf(from) != ClusterOf(to)) {
+			path.push_back(from);		// border crossing
+			continue;
+		}
+
+		SDL_Rect bounds = ClusterBounds(ClusterOf(from));
+		context.Reset();
+		context.unitRadius = unitRadius;
+		AStarSearch(context, from, to, &bounds);
+		expansions += context.expansions;
+		BuildPath(context, CellIndex(to), segment);
+		path.insert(path.end(), segment.begin() + 1, segment.end());
+	}
+	context.expansions = expansions;
 	return true;
 }
 
 //***************
-// MovingAABBAABBTest
-// dynamic pathfinding utility
-// AABB-AABB collision test where ONE is moving
-// returns true if already in collision
-// returns false if no collision will occur
-// otherwise returns the fraction along the movement
-// where collision first occurs
+// BuildNavMesh
+// greedily merges non-solid cells into rectangles, 
+// widest along cols first, then grown across as many rows as stay clear
+// and links every pair of rectangles sharing a border with a portal
 //***************
-bool MovingAABBAABBTest(const SDL_Rect & a, const SDL_Rect & b, const Vec2_t & va, const Vec2_t & vb, Vec2_t & times) {
+void BuildNavMesh() {
+	navMesh.regions.clear();
+	navMesh.portals.clear();
+	navMesh.regionOf.assign(gridCellCount, -1);
 
-	// started in collision
-	if (AABBAABBTest(a, b)) {
-		times = vec2zero;
+	auto Unclaimed = [](const int row, const int col) {
+		return !gameGrid.cells[row][col].solid && navMesh.regionOf[row * gridCols + col] == -1;
+	};
+
+	for (int row = 0; row < gridRows; row++) {
+		for (int col = 0; col < gridCols; col++) {
+			if (!Unclaimed(row, col))
+				continue;
+
+			int cols = 1;
+			while (col + cols < gridCols && Unclaimed(row, col + cols))
+				cols++;
+
+			int rows = 1;
+			for (bool clear = true; clear && row + rows < gridRows; rows += clear ? 1 : 0) {
+				for (int across = col; clear && across < col + cols; across++)
+					clear = Unclaimed(row + rows, across);
+			}
+
+			int region = navMesh.regions.size();
+			navMesh.regions.push_back(NavRegion_t{ SDL_Rect{ row, col, rows, cols }, {} });
+			for (int down = row; down < row + rows; down++) {
+				for (int across = col; across < col + cols; across++)
+					navMesh.regionOf[down * gridCols + across] = region;
+			}
+		}
+	}
+
+	// walk the far row and far col border of each region, one portal per run of the same neighbor
+	for (int region = 0; region < (int)navMesh.regions.size(); region++) {
+		const SDL_Rect & cells = navMesh.regions[region].cells;
+		for (int pass = 0; pass < 2; pass++) {
+			bool acrossRows = (pass == 0);
+			int border = acrossRows ? cells.x + cells.w : cells.y + cells.h;
+			int first = acrossRows ? cells.y : cells.x;
+			int last = first + (acrossRows ? cells.h : cells.w);
+			if (border >= (acrossRows ? gridRows : gridCols))
+				continue;
+
+			for (int start = first; start < last; ) {
+				auto RegionAt = [&](const int along) {
+					return acrossRows ? navMesh.regionOf[border * gridCols + along] : navMesh.regionOf[along * gridCols + border];
+				};
+				int neighbor = RegionAt(start);
+				int end = start + 1;
+				while (end < last && RegionAt(end) == neighbor)
+					end++;
+
+				if (neighbor != -1) {
+					NavPortal_t portal;
+					portal.regions[0] = region;
+					portal.regions[1] = neighbor;
+					portal.acrossRows = acrossRows;
+					for (int side = 0; side < 2; side++) {
+						int along = (side == 0 ? start : end - 1) * cellSize + cellSize / 2;
+						portal.ends[side] = acrossRows ? SDL_Point{ border * cellSize, along } : SDL_Point{ along, border * cellSize };
+					}
+					navMesh.regions[region].portals.push_back(navMesh.portals.size());
+					navMesh.regions[neighbor].portals.push_back(navMesh.portals.size());
+					navMesh.portals.push_back(portal);
+				}
+				start = end;
+			}
+		}
+	}
+}
+
+//***************
+// PointDistance
+// NavMeshSearch utility
+// straight line distance in pixels
+//***************
+int PointDistance(const SDL_Point & a, const SDL_Point & b) {
+	return (int)SDL_sqrt((double)((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y)));
+}
+
+//***************
+// TriangleArea2
+// NavMeshSearch utility
+// twice the signed area of abc, positive if c is left of the ray ab
+//***************
+int TriangleArea2(const SDL_Point & a, const SDL_Point & b, const SDL_Point & c) {
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+//***************
+// NavMeshSearch
+// A* search of navMesh portals from startCell's region to endCell's region,
+// then string-pulls the portal corridor with the funnel algorithm, and sets path (goal first) to the cells at its corners
+// falls back to AStarSearch of gameGrid cells if either cell has no region, or the regions aren't linked
+// regions are clear of solid cells, so paths also fit context.unitRadius 0, but not larger units
+// DEBUG: portals are searched once per side, since the region entered depends on the side they're crossed from
+//***************
+bool NavMeshSearch(SearchContext_t & context, GridCell_t * startCell, GridCell_t * endCell, Path_t & path) {
+	static thread_local OpenSet_t openSet(0);
+	static thread_local std::vector<int> gCosts;
+	static thread_local std::vector<int> parents;
+	static thread_local std::vector<Uint8> closed;
+	static thread_local std::vector<SDL_Point> points;
+	static thread_local std::vector<int> corridor;
+	static thread_local std::vector<std::array<SDL_Point, 2>> funnel;		// { left, right } of each portal crossed
+	static thread_local std::vector<std::array<GridCell_t *, 4>> funnelCells;		// { left exited, left entered, right exited, right entered }
+	static thread_local Path_t corners;
+	static thread_local Path_t segment;
+
+	int unitRadius = context.unitRadius;
+	int startRegion = navMesh.regionOf.empty() ? -1 : navMesh.regionOf[CellIndex(startCell)];
+	int endRegion = navMesh.regionOf.empty() ? -1 : navMesh.regionOf[CellIndex(endCell)];
+	if (startRegion == endRegion && startRegion != -1) {
+		path.clear();
+		path.push_back(endCell);
+		path.push_back(startCell);
 		return true;
 	}
 
-	// FIXME/BUG: the collision normal is not computed if the entity walked exactly up to the obstacle as to touch it this frame
-	// then NEXT frame its right on it, so NONE of the if conditions execute
+	// nodes are portal * 2 + the side of the region entered, and the goal
+	int goalNode = navMesh.portals.size() * 2;
+	bool found = false;
+	if (startRegion != -1 && endRegion != -1) {
+		if ((int)openSet.position.size() != goalNode + 1)
+			openSet = OpenSet_t(goalNode + 1);
+		openSet.Clear();
+		openSet.mode = OPENSET_BINARY_HEAP;
+		gCosts.assign(goalNode + 1, INT_MAX);
+		parents.assign(goalNode + 1, -1);
+		closed.assign(goalNode + 1, 0);
+		points.resize(goalNode + 1);
+
+		// each portal is crossed at its closest point to where the search crossed the one before
+		auto Relax = [&](const int node, const int parent, const SDL_Point & from, const int fromCost) {
+			if (closed[node])
+				return;
+
+			SDL_Point point = endCell->center;
+			if (node != goalNode) {
+				const NavPortal_t & portal = navMesh.portals[node / 2];
+				point = portal.ends[0];
+				if (portal.acrossRows)
+					point.y = from.y < portal.ends[0].y ? portal.ends[0].y : (from.y > portal.ends[1].y ? portal.ends[1].y : from.y);
+				else
+					point.x = from.x < portal.ends[0].x ? portal.ends[0].x : (from.x > portal.ends[1].x ? portal.ends[1].x : from.x);
+			}
 
-	Vec2_t aMin = { (float)a.x, (float)a.y };
-	Vec2_t aMax = { (float)(a.x + a.w), (float)(a.y + a.h) };
-	Vec2_t bMin = { (float)b.x, (float)b.y };
-	Vec2_t bMax = { (float)(b.x + b.w), (float)(b.y + b.h) };
-	Vec2_t relativeV = va;// -vb;		// FIXME/DEBUG: fully kinematic simulation with non-simultaneous motion doesn't need relative velocity
-	times.x = 0.0f;	// DEBUG: tFirst
-	times.y = 1.0f;	// DEBUG: tLast
+			int gCost = fromCost + PointDistance(from, point);
+			if (gCost >= gCosts[node])
+				return;
+			int hCost = PointDistance(point, endCell->center);
+			gCosts[node] = gCost;
+			parents[node] = parent;
+			points[node] = point;
+			openSet.Push(node, gCost + hCost, hCost);
+		};
+
+		for (auto && portal : navMesh.regions[startRegion].portals)
+			Relax(portal * 2 + (navMesh.portals[portal].regions[0] == startRegion ? 1 : 0), -1, startCell->center, 0);
+
+		while (!openSet.Empty()) {
+			int currentNode = openSet.Pop();
+			closed[currentNode] = 1;
+			context.expansions++;
+			if (currentNode == goalNode) {
+				found = true;
+				break;
+			}
 
-	// determine times of first and last contact, if any
-	for (int i = 0; i < 2; i++) {
-		if (relativeV[i] < 0.0f) {
-			if (aMax[i] < bMin[i]) return false; // non-intersecting and moving apart
-			if (bMax[i] < aMin[i]) times.x = Maximize((bMax[i] - aMin[i]) / relativeV[i], times.x);
-			if (aMax[i] > bMin[i]) times.y = Minimize((bMin[i] - aMax[i]) / relativeV[i], times.y);
+			int region = navMesh.portals[currentNode / 2].regions[currentNode % 2];
+			if (region == endRegion)
+				Relax(goalNode, currentNode, points[currentNode], gCosts[currentNode]);
+
+			for (auto && portal : navMesh.regions[region].portals) {
+				if (portal != currentNode / 2)
+					Relax(portal * 2 + (navMesh.portals[portal].regions[0] == region ? 1 : 0), currentNode, points[currentNode], gCosts[currentNode]);
+			}
 		}
-		if (relativeV[i] > 0.0f) {
-			if (aMin[i] > bMax[i]) return false; // non-intersecting and moving apart
-			if (aMax[i] < bMin[i]) times.x = Maximize((bMin[i] - aMax[i]) / relativeV[i], times.x);
-			if (bMax[i] > aMin[i]) times.y = Minimize((bMax[i] - aMin[i]) / relativeV[i], times.y);
+	}
+
+	if (!found) {
+		context.Reset();
+		context.unitRadius = unitRadius;
+		if (!AStarSearch(context, startCell, endCell))
+			return false;
+		BuildPath(context, CellIndex(endCell), path);
+		return true;
+	}
+
+	corridor.clear();
+	for (int node = parents[goalNode]; node != -1; node = parents[node])
+		corridor.push_back(node);
+
+	// orient each portal by the direction it's crossed, with the cells just past its ends
+	funnel.clear();
+	funnelCells.clear();
+	funnel.push_back({ startCell->center, startCell->center });
+	funnelCells.push_back({ startCell, startCell, startCell, startCell });
+	for (auto node = corridor.rbegin(); node != corridor.rend(); ++node) {
+		const NavPortal_t & portal = navMesh.portals[*node / 2];
+		int side = *node % 2;
+		bool flip = (side == 1) != portal.acrossRows;
+		std::array<GridCell_t *, 4> cells;
+		for (int end = 0; end < 2; end++) {
+			int row = portal.ends[end].x / cellSize;
+			int col = portal.ends[end].y / cellSize;
+			GridCell_t * lower = portal.acrossRows ? &gameGrid.cells[row - 1][col] : &gameGrid.cells[row][col - 1];
+			GridCell_t * upper = &gameGrid.cells[row][col];
+			int funnelEnd = (end == 0) == flip ? 0 : 2;
+			cells[funnelEnd] = side == 0 ? upper : lower;
+			cells[funnelEnd + 1] = side == 0 ? lower : upper;
 		}
-		
-		// generally, too far away to make contact
-		// DEBUG: if tFirst == tLast == 1.0f then this function returns true (a collision will occur)
-		// however, tFirst can also wind up as 0.0f but this function returns false, so tFirst ISN'T the final decider of collision
-		if (times.x > times.y)
+		funnel.push_back({ portal.ends[flip ? 0 : 1], portal.ends[flip ? 1 : 0] });
+		funnelCells.push_back(cells);
+	}
+	funnel.push_back({ endCell->center, endCell->center });
+	funnelCells.push_back({ endCell, endCell, endCell, endCell });
+
+	// simple stupid funnel algorithm, tightening the left and right sides of a funnel from the apex
+	// until one side crosses over the other, making that side's point the next apex
+	corners.clear();
+	int apex = 0;
+	int left = 0;
+	int right = 0;
+	corners.push_back(startCell);
+	for (int index = 1; index < (int)funnel.size(); index++) {
+		const SDL_Point & apexPoint = funnel[apex][0];
+		auto AtApex = [&](const SDL_Point & point) {
+			return point.x == apexPoint.x && point.y == apexPoint.y;
+		};
+
+		int corner = -1;
+		int end = 0;
+		if (TriangleArea2(apexPoint, funnel[right][1], funnel[index][1]) >= 0) {
+			if (AtApex(funnel[right][1]) || TriangleArea2(apexPoint, funnel[left][0], funnel[index][1]) < 0)
+				right = index;
+			else
+				corner = left;
+		}
+
+		if (corner == -1 && TriangleArea2(apexPoint, funnel[left][0], funnel[index][0]) <= 0) {
+			if (AtApex(funnel[left][0]) || TriangleArea2(apexPoint, funnel[right][1], funnel[index][0]) > 0)
+				left = index;
+			else {
+				corner = right;
+				end = 1;
+			}
+		}
+
+		// DEBUG: the corner point lies between two cells, take the one past it if it's in sight
+		if (corner != -1) {
+			funnel[corner][1 - end] = funnel[corner][end];
+			GridCell_t * exited = funnelCells[corner][end * 2];
+			GridCell_t * entered = funnelCells[corner][end * 2 + 1];
+			if (!LineOfSight(corners.back(), entered) && corners.back() != exited)
+				corners.push_back(exited);
+			if (corners.back() != entered)
+				corners.push_back(entered);
+			apex = left = right = corner;
+			index = corner;
+		}
+	}
+	if (corners.back() != endCell)
+		corners.push_back(endCell);
+
+	// cell centers can still clip a wall the corner points cleared, so walk the cells between those
+	path.clear();
+	path.push_back(endCell);
+	for (int index = corners.size() - 2; index >= 0; index--) {
+		if (LineOfSight(corners[index + 1], corners[index])) {
+			path.push_back(corners[index]);
+			continue;
+		}
+
+		int expansions = context.expansions;
+		context.Reset();
+		context.unitRadius = unitRadius;
+		bool walked = AStarSearch(context, corners[index], corners[index + 1]);
+		context.expansions += expansions;
+		if (!walked)
 			return false;
+		BuildPath(context, CellIndex(corners[index + 1]), segment);
+		path.insert(path.end(), segment.begin() + 1, segment.end());
 	}
 	return true;
 }
 
 //***************
-// CheckPathCell
-// used for dynamic pathfinding
-// DEBUG: never call this function with an empty path
+// PathCacheKey
+// pathCache utility
+// DEBUG: includes pathFindMode and anyAnglePaths since not every mode finds the same path
 //***************
-void CheckPathCell(std::shared_ptr<GameObject_t> & entity) {
-	if (entity->onPath && !AABBAABBTest(entity->bounds, entity->path.back()->bounds)) {	
-		entity->onPath = false;
-		entity->path.pop_back();										
+Uint64 PathCacheKey(const int startIndex, const int endIndex, const int unitRadius) {
+	Uint64 mode = ((Uint64)(unitRadius + 1) * 8 + pathFindMode) * 2 + (anyAnglePaths ? 1 : 0);		// DEBUG: fewer than 8 PathFindMode_t
+	return (mode * gridCellCount + startIndex) * gridCellCount + endIndex;
+}
+
+//***************
+// ClearPathCache
+// drops every cached path, eg: when collision changes
+// hits and misses keep counting
+//***************
+void ClearPathCache() {
+	std::lock_guard<std::mutex> guard(pathCache.lock);
+	pathCache.entries.clear();
+	pathCache.lookup.clear();
+}
+
+//***************
+// FindCachedPath
+// copies a cached path (goal first) from startCell to endCell
+// or the reverse of a cached path from endCell to startCell
+// returns false on a miss
+//***************
+bool FindCachedPath(GridCell_t * startCell, GridCell_t * endCell, const int unitRadius, Path_t & path) {
+	if (pathCache.capacity == 0)
+		return false;
+
+	std::lock_guard<std::mutex> guard(pathCache.lock);
+	bool reversed = false;
+	auto found = pathCache.lookup.find(PathCacheKey(CellIndex(startCell), CellIndex(endCell), unitRadius));
+	if (found == pathCache.lookup.end() && pathCache.reversible) {
+		found = pathCache.lookup.find(PathCacheKey(CellIndex(endCell), CellIndex(startCell), unitRadius));
+		reversed = true;
 	}
 
-	if (!entity->path.empty() && AABBAABBTest(entity->bounds, entity->path.back()->bounds)) {
-		entity->onPath = true;
+	if (found == pathCache.lookup.end()) {
+		pathCache.misses++;
+		return false;
 	}
+
+	pathCache.hits++;
+	pathCache.entries.splice(pathCache.entries.begin(), pathCache.entries, found->second);
+	const Path_t & cached = found->second->second;
+	if (reversed)
+		path.assign(cached.rbegin(), cached.rend());
+	else
+		path = cached;
+	return true;
 }
 
 //***************
-// CheckForwardCollision
-// returns the fraction along the current velocity where
-// touching first occurs between self and 
-// local entities or static obstacles, if any
-// DEBUG: never returns 0.0f which implies two things started in overlap/touching
-// sets the collision entity, if any
-// otherwise sets the collision entity to nullptr
+// CachePath
+// adds a path (goal first) from startCell to endCell to pathCache
+// evicting the least recently used path if full
 //***************
-float CheckForwardCollision(std::shared_ptr<GameObject_t> & self, const AreaContents_t & contents, std::shared_ptr<GameObject_t> & collisionEntity) {
+void CachePath(GridCell_t * startCell, GridCell_t * endCell, const int unitRadius, const Path_t & path) {
+	if (pathCache.capacity == 0)
+		return;
 
-	float nearest = 1.0f;
-	const Vec2_t selfMove = self->velocity * self->speed;
-	SDL_Rect broadPhaseBounds = GetBroadPhaseAABB(self);
-	SDL_Rect nextSelfBounds = TranslateRect(self->bounds, selfMove);
+	std::lock_guard<std::mutex> guard(pathCache.lock);
+	Uint64 key = PathCacheKey(CellIndex(startCell), CellIndex(endCell), unitRadius);
+	if (pathCache.lookup.find(key) != pathCache.lookup.end())
+		return;		// DEBUG: another worker got here first
 
-	// entity check
-	collisionEntity.reset();
-	for (auto && entity : contents.entities) {
+	if (pathCache.entries.size() >= pathCache.capacity) {
+		pathCache.lookup.erase(pathCache.entries.back().first);
+		pathCache.entries.pop_back();
+	}
+	pathCache.entries.emplace_front(key, path);
+	pathCache.lookup[key] = pathCache.entries.begin();
+}
 
-		// broad-phase test first,
-		// then so a swept AABB test on the next n steps
-		Vec2_t times;
-		if (AABBAABBTest(broadPhaseBounds, entity->bounds) &&
-			MovingAABBAABBTest(nextSelfBounds, entity->bounds, selfMove, entity->velocity * entity->speed, times)) {
+//***************
+// BuildLandmarks
+// picks up to landmarkCount landmarks spread across the largest component,
+// each the cell farthest from those already picked,
+// and stores every cell's path cost from each of them
+// DEBUG: cells outside the largest component keep the octile estimate
+//***************
+void BuildLandmarks() {
+	static std::vector<int> nearest;
+
+	landmarks.cells.clear();
+	landmarks.distances.assign(gridCellCount * landmarkCount, -1);
+	nearest.assign(gridCellCount, -1);
+
+	// the first landmark is the cell farthest from an arbitrary one
+	int picked = -1;
+	for (int index = 0; index < gridCellCount && picked == -1; index++) {
+		if (IndexToCell(index)->component == components.largest && components.largest != -1)
+			picked = index;
+	}
 
-			// DEBUG: don't even consider a move along a vector with ANY collision
-			collisionEntity = entity;
-			nearest = 0.0f;
-			break;
+	for (int landmark = -1; landmark < landmarkCount && picked != -1; landmark++) {
+		mainSearchContext.Reset();
+		AStarSearch(mainSearchContext, IndexToCell(picked), nullptr);
+
+		int farthest = -1;
+		for (int index = 0; index < gridCellCount; index++) {
+			if (!mainSearchContext.InClosedSet(index))
+				continue;
+
+			int distance = mainSearchContext.gCosts[index];
+			if (landmark >= 0)
+				landmarks.distances[index * landmarkCount + landmark] = distance;
+			if (landmark <= 0 || distance < nearest[index])
+				nearest[index] = distance;
+			if (farthest == -1 || nearest[index] > nearest[farthest])
+				farthest = index;
 		}
-	}
 
-	// static obstacle check
-	for (auto && obstacle : contents.obstacles) {
+		if (landmark >= 0)
+			landmarks.cells.push_back(picked);
+		picked = (farthest != -1 && nearest[farthest] > 0) ? farthest : -1;
+	}
+}
 
-		// broad-phase test first
-		// then so a swept AABB test on the next n steps
-		Vec2_t times;
-		if (AABBAABBTest(broadPhaseBounds, *obstacle) && 
-			MovingAABBAABBTest(nextSelfBounds, *obstacle, selfMove, { 0.0f, 0.0f }, times)) {
-				collisionEntity.reset();
-				nearest = 0.0f;
-				break;
-		}
+//***************
+// CollisionChecksum
+// FNV-1a hash of gameGrid collision, to match baked data with the map it was baked for
+//***************
+Uint32 CollisionChecksum() {
+	Uint32 hash = 2166136261u;
+	for (int index = 0; index < gridCellCount; index++) {
+		hash ^= IndexToCell(index)->solid ? 1u : 0u;
+		hash *= 16777619u;
 	}
-	return nearest;
+	return hash;
 }
 
 //***************
-// AvoidCollision
-// dynamic pathfinding utility
-// updates current velocity to avoid predicted collisions
-// with all area contents (dynamic and static obstacles)
-// returns the maximum fraction along any forward velocity
-// before that avoids all collision
+// ClearFirstMoves
+// drops the firstMoves table, so PATHFIND_FIRST_MOVES falls back to A*
 //***************
-float AvoidCollision(std::shared_ptr<GameObject_t> & self, const AreaContents_t & contents) {
-	static std::shared_ptr<GameObject_t> collisionEntity;
+void ClearFirstMoves() {
+	firstMoves.offsets.clear();
+	firstMoves.runs.clear();
+}
 
-	Vec2_t desiredVelocity = self->velocity;
+//***************
+// FirstMovesBytes
+// memory used by the firstMoves table
+//***************
+size_t FirstMovesBytes() {
+	return firstMoves.offsets.size() * sizeof(firstMoves.offsets[0]) + firstMoves.runs.size() * sizeof(firstMoves.runs[0]);
+}
 
-	// rotated 90 degrees CCW to setup for the 180 degree CW sweep
-	self->velocity = { -self->velocity.y, self->velocity.x };
+//***************
+// BakeFirstMoves
+// offline precompute of firstMoves, one Dijkstra search from every cell
+// passing on the direction of each search's first step to every cell reached through it
+// only steps a unit of unitRadius fits through are taken, see UnitFits
+// returns false (and leaves no table) if it would exceed firstMoves.budget
+//***************
+bool BakeFirstMoves(const int unitRadius) {
+	static OpenSet_t openSet;
+	static std::vector<int> costs;
+	static std::vector<Uint8> moves;
+
+	ClearFirstMoves();
+	firstMoves.unitRadius = unitRadius;
+	firstMoves.cornerCutting = navGraph.cornerCutting;
+	firstMoves.checksum = CollisionChecksum();
+	firstMoves.offsets.reserve(gridCellCount + 1);
+	openSet.mode = OPENSET_BINARY_HEAP;
+
+	for (int source = 0; source < gridCellCount; source++) {
+		costs.assign(gridCellCount, INT_MAX);
+		moves.assign(gridCellCount, firstMoveNone);
+		costs[source] = 0;
+		openSet.Push(source, 0, 0);
+		while (!openSet.Empty()) {
+			int currentIndex = openSet.Pop();
+			for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+				const NavEdge_t & step = navGraph.edges[edge];
+				if (unitRadius >= 0 && !UnitFits(currentIndex, step, unitRadius))
+					continue;
 
-	float bestWeight = 0.0f;
-	float bestFraction = 0.0f;
-	Vec2_t bestVelocity = vec2zero;
+				int cost = costs[currentIndex] + step.cost;
+				if (cost < costs[step.cell]) {
+					costs[step.cell] = cost;
+					moves[step.cell] = (currentIndex == source) ? step.direction : moves[currentIndex];
+					openSet.Push(step.cell, cost, 0);
+				}
+			}
+		}
 
-	// check a 180 degree forward arc maximizing movement along path
-	for (int angle = 0; angle < 180; angle++) {
-		Rotate(CLOCKWISE, self->velocity);
-		float fraction = CheckForwardCollision(self, contents, collisionEntity);	// DEBUG: forced to either 0.0f or 1.0f
-		float weight = (self->velocity * desiredVelocity);
+		// DEBUG: PathFind never asks for solid targets or those in another component,
+		// but targets of the same component too tight for the unit must stay firstMoveNone
+		firstMoves.offsets.push_back(firstMoves.runs.size());
+		int rowStart = firstMoves.runs.size();
+		int component = IndexToCell(source)->component;
+		for (int target = 0; target < gridCellCount; target++) {
+			GridCell_t * targetCell = IndexToCell(target);
+			Uint16 move = moves[target];
+			bool anyMove = target == source || 
+							(move == firstMoveNone && (targetCell->solid || component == -1 || targetCell->component != component));
+			if (anyMove)
+				continue;
+
+			if ((int)firstMoves.runs.size() == rowStart)
+				firstMoves.runs.push_back(move);		// DEBUG: the targets skipped so far join the first run
+			else if ((firstMoves.runs.back() & 15) != move)
+				firstMoves.runs.push_back((Uint16)(target << 4) | move);
+		}
 
-		if (fraction > bestFraction || (fraction == bestFraction && weight > bestWeight)) {
-			bestWeight = weight;
-			bestFraction = fraction;
-			bestVelocity = self->velocity;
+		if (FirstMovesBytes() > firstMoves.budget) {
+			ClearFirstMoves();
+			return false;
 		}
 	}
-	self->velocity = bestVelocity;
-	return bestFraction;
+	firstMoves.offsets.push_back(firstMoves.runs.size());
+	return true;
 }
 
 //***************
-// Collide
-// collision response called by the sender
-// TODO: possibly invoke this during Move
+// SaveFirstMoves
+// writes the firstMoves table beside the collision map
 //***************
-void Collide(std::shared_ptr<GameObject_t> & sender, std::shared_ptr<GameObject_t> & receiver) {
-	//	entities[1]->blinkTime = SDL_GetTicks() + 1000;
-	//	entities[1]->damaged = true;
-	//	entities[1]->health = -10;
+bool SaveFirstMoves() {
+	if (firstMoves.offsets.empty())
+		return false;
+
+	std::ofstream write(firstMovesFile, std::ios::binary);
+	if (!write.good())
+		return false;
+
+	Uint32 header[6] = { gridRows, gridCols, (Uint32)(firstMoves.unitRadius + 1), firstMoves.cornerCutting ? 1u : 0u, 
+						firstMoves.checksum, (Uint32)firstMoves.runs.size() };
+	write.write((const char *)header, sizeof(header));
+	write.write((const char *)firstMoves.offsets.data(), firstMoves.offsets.size() * sizeof(firstMoves.offsets[0]));
+	write.write((const char *)firstMoves.runs.data(), firstMoves.runs.size() * sizeof(firstMoves.runs[0]));
+	return write.good();
 }
 
 //***************
-// Walk
-// dynamic pathfinding
+// LoadFirstMoves
+// reads the firstMoves table saved by SaveFirstMoves
+// returns false (and leaves no table) if it is missing, over budget, baked for other collision, or corrupt
 //***************
-void Walk(std::shared_ptr<GameObject_t> & entity) {
-	static AreaContents_t areaContents;						// fetched and used once per frame per entity, then cleared
+bool LoadFirstMoves() {
+	ClearFirstMoves();
+	std::ifstream read(firstMovesFile, std::ios::binary);
+	if (!read.good())
+		return false;
 
-	Uint32 dt = SDL_GetTicks() - entity->moveTime;
+	Uint32 header[6];
+	read.read((char *)header, sizeof(header));
+	size_t bytes = (gridCellCount + 1) * sizeof(firstMoves.offsets[0]) + header[5] * sizeof(firstMoves.runs[0]);
+	if (read.fail() || header[0] != gridRows || header[1] != gridCols || header[3] != (navGraph.cornerCutting ? 1u : 0u) ||
+		header[4] != CollisionChecksum() || bytes > firstMoves.budget) {
+		return false;
+	}
 
-	if (dt >= 25) {
-		entity->moveTime = SDL_GetTicks();
+	firstMoves.offsets.resize(gridCellCount + 1);
+	firstMoves.runs.resize(header[5]);
+	read.read((char *)firstMoves.offsets.data(), firstMoves.offsets.size() * sizeof(firstMoves.offsets[0]));
+	read.read((char *)firstMoves.runs.data(), firstMoves.runs.size() * sizeof(firstMoves.runs[0]));
+	if (read.fail() || firstMoves.offsets[0] != 0 || firstMoves.offsets[gridCellCount] != (int)firstMoves.runs.size()) {
+		ClearFirstMoves();
+		return false;
+	}
+
+	// DEBUG: FirstMoveSearch trusts every row's runs and moves, so a corrupt table is dropped instead
+	for (int index = 0; index < gridCellCount; index++) {
+		if (firstMoves.offsets[index + 1] < firstMoves.offsets[index]) {
+			ClearFirstMoves();
+			return false;
+		}
+
+		for (int run = firstMoves.offsets[index]; run < firstMoves.offsets[index + 1]; run++) {
+			int move = firstMoves.runs[run] & 15;
+			if (move > firstMoveNone || (move != firstMoveNone && !((navGraph.walkable[index] >> move) & 1))) {
+				ClearFirstMoves();
+				return false;
+			}
+		}
+	}
+
+	firstMoves.unitRadius = (int)header[2] - 1;
+	firstMoves.cornerCutting = header[3] != 0;
+	firstMoves.checksum = header[4];
+	return true;
+}
+
+//***************
+// FirstMove
+// neighborOffsets direction of the first step from cellIndex towards targetIndex, or firstMoveNone
+//***************
+int FirstMove(const int cellIndex, const int targetIndex) {
+	auto first = firstMoves.runs.begin() + firstMoves.offsets[cellIndex];
+	auto last = firstMoves.runs.begin() + firstMoves.offsets[cellIndex + 1];
+	auto run = std::upper_bound(first, last, (Uint16)((targetIndex << 4) | 15));
+	if (run == first)
+		return firstMoveNone;
+	return *(run - 1) & 15;
+}
+
+//***************
+// FirstMoveSearch
+// sets path (goal first) by following firstMoves from startCell to endCell, no search needed
+// DEBUG: PathFind searches from a solid startCell with A* instead, as for JPS+
+// gives up after gridCellCount steps rather than loop on a loaded table whose moves cycle
+//***************
+bool FirstMoveSearch(GridCell_t * startCell, GridCell_t * endCell, Path_t & path) {
+	int endIndex = CellIndex(endCell);
+	path.clear();
+	path.push_back(startCell);
+	for (int index = CellIndex(startCell); index != endIndex; index = CellIndex(path.back())) {
+		int move = FirstMove(index, endIndex);
+		if (move == firstMoveNone || (int)path.size() > gridCellCount) {
+			path.clear();
+			return false;
+		}
+
+		GridCell_t * cell = IndexToCell(index);
+		path.push_back(&gameGrid.cells[cell->gridRow + neighborOffsets[move].x][cell->gridCol + neighborOffsets[move].y]);
+	}
+	path.reverse();
+	return true;
+}
+
+//***************
+// BakeNavigation
+// precomputes static pathfinding data
+// DEBUG: call again whenever gameGrid cell solidity changes, see SetCellSolid
+//***************
+void BakeNavigation() {
+	BakeNavGraph();
+	BakeClearance();
+	LabelComponents();
+	BuildLandmarks();
+	BakeJumpTable(BakedUnitRadius());
+	BuildHierarchy(BakedUnitRadius());
+	BuildNavMesh();
+	ClearPathCache();
+	collisionChanges.cells.clear();
+	collisionChanges.bakes++;
+
+	// DEBUG: the table survives re-baking the map it was baked for
+	if (firstMoves.checksum != CollisionChecksum() || firstMoves.cornerCutting != navGraph.cornerCutting)
+		ClearFirstMoves();
+}
+
+//***************
+// SetCellSolid
+// changes a cell's collision at runtime
+// and rebuilds the pathfinding data that depends on it
+//***************
+void SetCellSolid(GridCell_t & cell, const bool solid) {
+	if (cell.solid == solid)
+		return;
+
+	cell.solid = solid;
+	BakeNavGraph();
+	BakeClearance();
+	LabelComponents();
+	BuildLandmarks();
+	BakeJumpTable(BakedUnitRadius());
+	RebuildCluster(ClusterOf(&cell));
+	BuildNavMesh();
+	ClearPathCache();
+	ClearFirstMoves();
+	collisionChanges.cells.push_back(CellIndex(&cell));
+}
+
+//***************
+// NearestReachableCell
+// PathFind utility
+// snaps goalCell to the closest non-solid cell startCell can reach,
+// scanning rings of cells outward from goalCell, and breaking ties towards startCell
+// and fits a unit of unitRadius, see UnitFits
+// returns goalCell itself if it is reachable, or nullptr if startCell is walled in
+// DEBUG: components ignore unit size, so a snapped cell may still be out of reach through tight gaps
+//***************
+GridCell_t * NearestReachableCell(GridCell_t * startCell, GridCell_t * goalCell, const int unitRadius = -1) {
+	int component = startCell->component;
+
+	// DEBUG: an entity overlapping collision reaches whatever its first step does
+	if (startCell->solid) {
+		int startIndex = CellIndex(startCell);
+		if (navGraph.offsets[startIndex] == navGraph.offsets[startIndex + 1])
+			return nullptr;
+		component = IndexToCell(navGraph.edges[navGraph.offsets[startIndex]].cell)->component;
+	}
+
+	if (!goalCell->solid && goalCell->component == component && clearance.distances[CellIndex(goalCell)] > unitRadius)
+		return goalCell;
+
+	// every cell of the ring at radius is at least 10 * radius from goalCell
+	GridCell_t * best = nullptr;
+	int bestDistance = INT_MAX;
+	int maxRadius = gridRows > gridCols ? gridRows : gridCols;
+	for (int radius = 1; radius < maxRadius && 10 * radius <= bestDistance; radius++) {
+		int top = goalCell->gridRow - radius;
+		int bottom = goalCell->gridRow + radius;
+		for (int row = (top < 0 ? 0 : top); row <= bottom && row < gridRows; row++) {
+
+			// whole rows along the top and bottom of the ring, only its two ends between
+			int colStep = (row == top || row == bottom) ? 1 : 2 * radius;
+			for (int col = goalCell->gridCol - radius; col <= goalCell->gridCol + radius; col += colStep) {
+				if (col < 0 || col >= gridCols)
+					continue;
+
+				GridCell_t * cell = &gameGrid.cells[row][col];
+				if (cell->solid || cell->component != component || clearance.distances[row * gridCols + col] <= unitRadius)
+					continue;
+
+				int distance = GetDistance(cell, goalCell);
+				if (distance < bestDistance || 
+					(distance == bestDistance && GetDistance(cell, startCell) < GetDistance(best, startCell))) {
+					best = cell;
+					bestDistance = distance;
+				}
+			}
+		}
+	}
+	return best;
+}
+
+//***************
+// PathFind
+// search of gameGrid cells using the current pathFindMode
+// only searches static non-solid geometry
+// entities will perform dynamic collision avoidance on the fly
+// context holds all per-search state, so searches on separate contexts can run concurrently
+// returns false if no valid path is found (also clears the current path)
+// returns true if a valid path was constructed (after clearing the current path)
+//***************
+bool PathFind(std::shared_ptr<GameObject_t> & entity, const SDL_Point & start, const SDL_Point & goal, SearchContext_t & context = mainSearchContext) {
+
+	int startRow;
+	int startCol;
+	int endRow;
+	int endCol;
+	PointToCell(start, startRow, startCol);
+	PointToCell(goal, endRow, endCol);
+
+	GridCell_t * startCell = &gameGrid.cells[startRow][startCol];
+	GridCell_t * endCell = &gameGrid.cells[endRow][endCol];
+
+	int unitRadius = PathUnitRadius(*entity);
+
+	// DEBUG: a solid startCell still searches, in case the entity is overlapping collision
+	if (endCell->solid || startCell == endCell || (!startCell->solid && !CellsConnected(startCell, endCell)) ||
+		clearance.distances[CellIndex(endCell)] <= unitRadius) {
+		entity->path.clear();
+		return false;
+	}
+
+	// ensure no conflicts with previous searches on this context
+	context.Reset();
+	context.unitRadius = unitRadius;
+
+	if (context.congestion == 0 && FindCachedPath(startCell, endCell, unitRadius, entity->path)) {
+		entity->onPath = true;
+		return true;
+	}
+
+	// DEBUG: jumpTable, hierarchy, and firstMoves only hold routes for the unit size they were baked for, see BakedUnitRadius,
+	// jumpTable has no jumps out of solid cells, firstMoves rows of solid cells have no component to be checked against, navMesh regions only fit units one cell across, and only AStarSearch adds congestion
+	PathFindMode_t mode = pathFindMode;
+	if (mode == PATHFIND_JPS_PLUS && (jumpTable.distances.empty() || jumpTable.unitRadius != unitRadius || startCell->solid))
+		mode = PATHFIND_JPS;
+	if (mode == PATHFIND_HPA && hierarchy.unitRadius != unitRadius)
+		mode = PATHFIND_ASTAR;
+	if (mode == PATHFIND_FIRST_MOVES && (firstMoves.offsets.empty() || firstMoves.unitRadius != unitRadius || startCell->solid))
+		mode = PATHFIND_ASTAR;
+	if (mode == PATHFIND_NAVMESH && unitRadius > 0)
+		mode = PATHFIND_ASTAR;
+	if (context.congestion > 0)
+		mode = PATHFIND_ASTAR;
+
+	// DEBUG: PATHFIND_HPA, PATHFIND_BIDIRECTIONAL, PATHFIND_FIRST_MOVES, and PATHFIND_NAVMESH set their own paths
+	bool found = false;
+	switch (mode) {
+		case PATHFIND_ASTAR: found = AStarSearch(context, startCell, endCell); break;
+		case PATHFIND_JPS: found = JumpPointSearch(context, startCell, endCell); break;
+		case PATHFIND_JPS_PLUS: found = JumpPointPlusSearch(context, startCell, endCell); break;
+		case PATHFIND_HPA: found = HierarchicalSearch(context, startCell, endCell, entity->path); break;
+		case PATHFIND_BIDIRECTIONAL: found = BidirectionalSearch(context, startCell, endCell, entity->path); break;
+		case PATHFIND_FIRST_MOVES: found = FirstMoveSearch(startCell, endCell, entity->path); break;
+		case PATHFIND_NAVMESH: found = NavMeshSearch(context, startCell, endCell, entity->path); break;
+	}
+
+	if (!found) {
+		entity->path.clear();
+		return false;		// DEBUG: this will be hit if an entity is surrounded by entities on its first search
+	}
+
+	// build the path back (reverse iterator)
+	// TODO: instead push a flowVelocity at each index (maybe?)
+	if (mode != PATHFIND_HPA && mode != PATHFIND_BIDIRECTIONAL && mode != PATHFIND_FIRST_MOVES && mode != PATHFIND_NAVMESH)
+		BuildPath(context, CellIndex(endCell), entity->path);
+	if (anyAnglePaths)
+		SmoothPath(entity->path, unitRadius < 0 ? 0 : unitRadius);
+	if (context.congestion == 0)
+		CachePath(startCell, endCell, unitRadius, entity->path);
+
+	// the path starts on the entity's current cell
+	entity->onPath = true;
+	return true;
+}
+
+//***************
+// RunPathRequests
+// claims and runs requests from the current batch until none are left
+//***************
+void RunPathRequests(std::vector<PathRequest_t> & requests, SearchContext_t & context) {
+	for (int index = pathWorkers.nextRequest++; index < (int)requests.size(); index = pathWorkers.nextRequest++) {
+		PathRequest_t & request = requests[index];
+		context.congestion = request.congestion;
+		request.found = PathFind(request.entity, request.start, request.goal, context);
+		context.congestion = 0;
+	}
+}
+
+//***************
+// PathWorker
+// pathfinding worker thread loop
+// lastBatch is the batchCount when the thread was started
+//***************
+void PathWorker(Uint32 lastBatch) {
+	SearchContext_t context;
+
+	std::unique_lock<std::mutex> lock(pathWorkers.lock);
+	while (true) {
+		pathWorkers.wake.wait(lock, [&lastBatch]() { return pathWorkers.quit || pathWorkers.batchCount != lastBatch; });
+		if (pathWorkers.quit)
+			return;
+
+		lastBatch = pathWorkers.batchCount;
+		std::vector<PathRequest_t> * batch = pathWorkers.batch;
+		lock.unlock();
+
+		RunPathRequests(*batch, context);
+
+		lock.lock();
+		if (--pathWorkers.pending == 0)
+			pathWorkers.finished.notify_one();
+	}
+}
+
+//***************
+// StartPathWorkers
+// spawns the threads used by PathFindBatch
+//***************
+void StartPathWorkers(const int count) {
+	pathWorkers.batch = nullptr;
+	pathWorkers.batchCount = 0;
+	pathWorkers.pending = 0;
+	pathWorkers.quit = false;
+	for (int thread = 0; thread < count; thread++)
+		pathWorkers.threads.push_back(std::thread(PathWorker, pathWorkers.batchCount));
+}
+
+//***************
+// StopPathWorkers
+// joins all PathFindBatch threads
+// DEBUG: never call this during a PathFindBatch
+//***************
+void StopPathWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(pathWorkers.lock);
+		pathWorkers.quit = true;
+	}
+	pathWorkers.wake.notify_all();
+
+	for (auto && thread : pathWorkers.threads)
+		thread.join();
+	pathWorkers.threads.clear();
+}
+
+//***************
+// PathFindBatch
+// runs PathFind for every request, spread across the pathWorkers threads and the main thread
+// blocks until all requests are done, so results are set before the next Think
+//***************
+void PathFindBatch(std::vector<PathRequest_t> & requests) {
+	if (pathWorkers.threads.empty() || requests.size() < pathBatchSerialLimit) {
+		for (auto && request : requests) {
+			mainSearchContext.congestion = request.congestion;
+			request.found = PathFind(request.entity, request.start, request.goal, mainSearchContext);
+			mainSearchContext.congestion = 0;
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(pathWorkers.lock);
+	pathWorkers.batch = &requests;
+	pathWorkers.nextRequest = 0;
+	pathWorkers.pending = pathWorkers.threads.size();
+	pathWorkers.batchCount++;
+	lock.unlock();
+	pathWorkers.wake.notify_all();
+
+	RunPathRequests(requests, mainSearchContext);
+
+	// DEBUG: wait on every worker, even ones that found nothing left to claim, before the batch goes out of scope
+	lock.lock();
+	pathWorkers.finished.wait(lock, []() { return pathWorkers.pending == 0; });
+	pathWorkers.batch = nullptr;
+}
+
+//***************
+// BuildFlowField
+// reverse Dijkstra search of gameGrid cells from goalCell
+// so every cell that can reach goalCell knows its next step there
+// only steps a unit of unitRadius fits through are followed, see UnitFits
+// and each cell stepped onto costs congestion more per unit standing in it, see density
+// returns false if goalCell is solid (the field is left empty)
+//***************
+bool BuildFlowField(FlowField_t & flowField, GridCell_t * goalCell, const int unitRadius = -1, const int congestion = 0) {
+
+	// DEBUG: static to prevent excessive dynamic allocation
+	static OpenSet_t openSet;
+
+	flowField.goalCell = goalCell;
+	flowField.unitRadius = unitRadius;
+	flowField.costs.fill(-1);
+	flowField.directions.fill(-1);
+	if (goalCell->solid)
+		return false;
+
+	// openset sort priority: gCost only
+	openSet.mode = openSetMode;
+
+	int goalIndex = CellIndex(goalCell);
+	flowField.costs[goalIndex] = 0;
+	openSet.Push(goalIndex, 0, 0);
+	while (!openSet.Empty()) {
+		int currentIndex = openSet.Pop();
+
+		// popped cells already have their lowest cost, so need no closedSet
+		// DEBUG: the entity steps the other way, from neighbor to currentCell
+		for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			int neighborIndex = step.cell;
+			if (unitRadius >= 0 && !UnitFits(neighborIndex, NavEdge_t{ (Uint16)currentIndex, step.cost, (Uint8)(7 - step.direction) }, unitRadius))
+				continue;
+
+			int cost = flowField.costs[currentIndex] + step.cost + congestion * density.counts[currentIndex];
+			if (flowField.costs[neighborIndex] == -1 || cost < flowField.costs[neighborIndex]) {
+				flowField.costs[neighborIndex] = cost;
+				flowField.directions[neighborIndex] = 7 - step.direction;		// step back towards currentCell
+				openSet.Push(neighborIndex, cost, 0);
+			}
+		}
+	}
+	return true;
+}
+
+//***************
+// RerootFlowField
+// moves a flow field's goalCell without rebuilding it
+// every route first continues on through the old goalCell, which raises each cost by that of the new goalCell,
+// then only the cells that have a shorter route to the new goalCell are relaxed outward from it
+// returns the number of cells relaxed
+// DEBUG: goalCell must be reachable in the current field, and fit its unitRadius
+//***************
+int RerootFlowField(FlowField_t & flowField, GridCell_t * goalCell) {
+
+	// DEBUG: static to prevent excessive dynamic allocation
+	static OpenSet_t openSet;
+	static std::vector<int> route;
+
+	int goalIndex = CellIndex(goalCell);
+	int offset = flowField.costs[goalIndex];
+	for (auto && cost : flowField.costs) {
+		if (cost >= 0)
+			cost += offset;
+	}
+
+	// flip the old route from goalCell to the old goalCell, so it leads back to goalCell
+	// DEBUG: from the far end, since each cell's new direction is the reverse of the old one before it
+	route.clear();
+	for (GridCell_t * cell = goalCell; cell != nullptr; cell = flowField.Next(cell))
+		route.push_back(CellIndex(cell));
+
+	openSet.mode = openSetMode;
+	for (size_t step = route.size() - 1; step > 0; step--) {
+		int index = route[step];
+		int oldCost = flowField.costs[index] - offset;
+		flowField.costs[index] = offset - oldCost;
+		flowField.directions[index] = 7 - flowField.directions[route[step - 1]];
+		openSet.Push(index, flowField.costs[index], 0);
+	}
+	flowField.goalCell = goalCell;
+	flowField.costs[goalIndex] = 0;
+	flowField.directions[goalIndex] = -1;
+	openSet.Push(goalIndex, 0, 0);
+
+	// every cost is still a real route's cost, so relaxing the improved cells leaves only shortest routes
+	int relaxed = 0;
+	while (!openSet.Empty()) {
+		int currentIndex = openSet.Pop();
+		relaxed++;
+
+		for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			if (flowField.unitRadius >= 0 && 
+				!UnitFits(step.cell, NavEdge_t{ (Uint16)currentIndex, step.cost, (Uint8)(7 - step.direction) }, flowField.unitRadius)) {
+				continue;
+			}
+
+			int cost = flowField.costs[currentIndex] + step.cost;
+			if (cost < flowField.costs[step.cell]) {
+				flowField.costs[step.cell] = cost;
+				flowField.directions[step.cell] = 7 - step.direction;
+				openSet.Push(step.cell, cost, 0);
+			}
+		}
+	}
+	return relaxed;
+}
+
+//***************
+// UpdateChaseTree
+// keeps chaseTree rooted at rootCell
+// rerooting it as the root moves, and only rebuilding it after collision changes
+// DEBUG: a solid rootCell (Goodman overlapping collision) keeps the last root
+//***************
+void UpdateChaseTree(GridCell_t * rootCell) {
+	if (rootCell->solid)
+		return;
+
+	if (!chaseTree.field)
+		chaseTree.field = std::make_shared<FlowField_t>();
+
+	FlowField_t & field = *chaseTree.field;
+	bool stale = field.goalCell == nullptr || 
+				chaseTree.bakes != collisionChanges.bakes || 
+				chaseTree.changeCursor != collisionChanges.cells.size() ||
+				field.costs[CellIndex(rootCell)] < 0;
+	if (stale) {
+		BuildFlowField(field, rootCell);
+		chaseTree.bakes = collisionChanges.bakes;
+		chaseTree.changeCursor = collisionChanges.cells.size();
+	} else if (field.goalCell != rootCell) {
+		RerootFlowField(field, rootCell);
+	}
+}
+
+//***************
+// ReservationOwner
+// WHCA* utility
+// guid of the entity holding the cell at the tick, or -1 if free
+//***************
+int ReservationOwner(const int cellIndex, const Uint32 tick) {
+	if (reservationTable.owners.empty())
+		return -1;
+
+	int slot = (tick % reservationSlots) * gridCellCount + cellIndex;
+	return reservationTable.ticks[slot] == tick ? reservationTable.owners[slot] : -1;
+}
+
+//***************
+// Reserve
+// WHCA* utility
+//***************
+void Reserve(const int cellIndex, const Uint32 tick, const int guid) {
+	if (reservationTable.owners.empty()) {
+		reservationTable.owners.assign(gridCellCount * reservationSlots, -1);
+		reservationTable.ticks.assign(gridCellCount * reservationSlots, UINT_MAX);
+	}
+
+	int slot = (tick % reservationSlots) * gridCellCount + cellIndex;
+	reservationTable.owners[slot] = guid;
+	reservationTable.ticks[slot] = tick;
+}
+
+//***************
+// ReleaseReservations
+// WHCA* utility
+// frees every cell still held by the entity's reservedCells
+//***************
+void ReleaseReservations(std::shared_ptr<GameObject_t> & entity) {
+	for (size_t step = 0; step < entity->reservedCells.size(); step++) {
+		int cellIndex = CellIndex(entity->reservedCells[step]);
+		Uint32 tick = entity->reservedTick + step;
+		if (ReservationOwner(cellIndex, tick) == entity->guid)
+			reservationTable.ticks[(tick % reservationSlots) * gridCellCount + cellIndex] = UINT_MAX;
+	}
+}
+
+//***************
+// CellHeldByIdle
+// WHCA* utility
+// true if another entity that isn't following reservations stands still in the cell
+// DEBUG: those never enter reservationTable, so are planned around for the whole window
+//***************
+bool CellHeldByIdle(const GridCell_t * cell, const std::shared_ptr<GameObject_t> & entity) {
+	for (auto && other : cell->contents) {
+		if (other != entity && other->type != OBJECTTYPE_MISSILE && other->reservedCells.empty() && other->velocity == vec2zero)
+			return true;
+	}
+	return false;
+}
+
+//***************
+// ReserveCooperativePath
+// windowed cooperative A* (WHCA*) for one entity following a group order's flowField
+// searches cell and tick pairs for reservationWindow ticks from now, waiting in place when needed, 
+// avoiding cells and head-on swaps reserved by others, with flowField costs as the heuristic
+// then reserves and sets the result as entity->reservedCells
+// returns false if the window ends no closer to the goal
+//***************
+bool ReserveCooperativePath(std::shared_ptr<GameObject_t> & entity, GridCell_t * startCell) {
+	static const int stateCount = gridCellCount * reservationSlots;		// by tick * gridCellCount + CellIndex
+	static OpenSet_t openSet(stateCount);
+	static std::vector<int> gCosts(stateCount, 0);
+	static std::vector<int> parents(stateCount, -1);
+	static std::vector<Uint32> closedStamps(stateCount, 0);
+	static Uint32 generation = 0;
+
+	const FlowField_t & flowField = *entity->flowField;
+	Uint32 now = reservationTable.now;
+	int startIndex = CellIndex(startCell);
+	int goalIndex = CellIndex(flowField.goalCell);
+
+	ReleaseReservations(entity);
+	entity->reservedCells.clear();
+	entity->reservedTick = now;
+
+	if (++generation == 0) {	// DEBUG: rare wrap-around, stale stamps could match again
+		std::fill(closedStamps.begin(), closedStamps.end(), 0);
+		generation = 1;
+	}
+	openSet.Clear();
+	openSet.mode = OPENSET_BINARY_HEAP;
+
+	// DEBUG: a startCell that can't reach the goal is treated as one step from it
+	int startCost = flowField.costs[startIndex] < 0 ? 10 : flowField.costs[startIndex];
+	gCosts[startIndex] = 0;
+	parents[startIndex] = -1;
+	openSet.Push(startIndex, startCost, startCost);
+
+	int endState = -1;
+	while (!openSet.Empty()) {
+		int state = openSet.Pop();
+		closedStamps[state] = generation;
+
+		int tick = state / gridCellCount;
+		int cellIndex = state % gridCellCount;
+		if (tick == reservationWindow || cellIndex == goalIndex) {
+			endState = state;
+			break;
+		}
+
+		// the navGraph edges, then waiting in place
+		GridCell_t * cell = IndexToCell(cellIndex);
+		for (int edge = navGraph.offsets[cellIndex]; edge <= navGraph.offsets[cellIndex + 1]; edge++) {
+			GridCell_t * next = (edge < navGraph.offsets[cellIndex + 1]) ? IndexToCell(navGraph.edges[edge].cell) : cell;
+
+			// DEBUG: diagonal steps take two ticks, since Walk rounds each axis of a diagonal move down to 1px
+			int nextIndex = CellIndex(next);
+			int duration = (next->gridRow != cell->gridRow && next->gridCol != cell->gridCol) ? 2 : 1;
+			int nextState = (tick + duration) * gridCellCount + nextIndex;
+			if (tick + duration > reservationWindow || closedStamps[nextState] == generation || flowField.costs[nextIndex] < 0)
+				continue;
+
+			int owner = ReservationOwner(nextIndex, now + tick + 1);
+			int arrivalOwner = ReservationOwner(nextIndex, now + tick + duration);
+			if ((owner != -1 && owner != entity->guid) || 
+				(arrivalOwner != -1 && arrivalOwner != entity->guid) ||
+				(next != startCell && CellHeldByIdle(next, entity))) {
+				continue;
+			}
+
+			// head-on swap with whoever leaves next for this cell
+			int swapOwner = (next == cell) ? -1 : ReservationOwner(nextIndex, now + tick);
+			if (swapOwner != -1 && swapOwner != entity->guid && ReservationOwner(cellIndex, now + tick + 1) == swapOwner)
+				continue;
+
+			int gCost = gCosts[state] + (next == cell ? 10 : GetDistance(cell, next));
+			if (!openSet.Contains(nextState) || gCost < gCosts[nextState]) {
+				int hCost = flowField.costs[nextIndex];
+				gCosts[nextState] = gCost;
+				parents[nextState] = state;
+				openSet.Push(nextState, gCost + hCost, hCost);
+			}
+		}
+	}
+
+	if (endState == -1) {
+		entity->reservedCells.push_back(startCell);
+	} else {
+		for (int state = endState; state != -1; state = parents[state]) {
+			GridCell_t * cell = IndexToCell(state % gridCellCount);
+			entity->reservedCells.push_back(cell);
+			if (parents[state] != -1 && state / gridCellCount - parents[state] / gridCellCount == 2)
+				entity->reservedCells.push_back(cell);
+		}
+		entity->reservedCells.reverse();
+	}
+
+	// hold the last cell for the rest of the window
+	while ((int)entity->reservedCells.size() <= reservationWindow)
+		entity->reservedCells.push_back(entity->reservedCells.back());
+
+	for (size_t step = 0; step < entity->reservedCells.size(); step++)
+		Reserve(CellIndex(entity->reservedCells[step]), now + step, entity->guid);
+	return flowField.costs[CellIndex(entity->reservedCells.back())] < flowField.costs[startIndex];
+}
+
+//***************
+// DStarLiteLookahead
+// D* Lite utility
+// lowest cost to the goal through one of the cell's non-solid neighbors
+//***************
+int DStarLiteLookahead(const DStarLite_t & planner, GridCell_t * cell) {
+	int best = dstarInfinity;
+	int cellIndex = CellIndex(cell);
+	for (int edge = navGraph.offsets[cellIndex]; edge < navGraph.offsets[cellIndex + 1]; edge++) {
+		const NavEdge_t & step = navGraph.edges[edge];
+		int cost = planner.gCosts[step.cell] + step.cost;
+		if (cost < best)
+			best = cost;
+	}
+	return best;
+}
+
+//***************
+// UpdateDStarLiteCell
+// D* Lite utility
+// refreshes the cell's rhsCost and queues it only if it became inconsistent
+//***************
+void UpdateDStarLiteCell(DStarLite_t & planner, const int cellIndex) {
+	GridCell_t * cell = IndexToCell(cellIndex);
+	if (cellIndex != planner.goalIndex)
+		planner.rhsCosts[cellIndex] = DStarLiteLookahead(planner, cell);
+
+	int gCost = planner.gCosts[cellIndex];
+	int rhsCost = planner.rhsCosts[cellIndex];
+	if (gCost == rhsCost) {
+		if (planner.openSet.Contains(cellIndex))
+			planner.openSet.Remove(cellIndex);
+		return;
+	}
+
+	int minCost = gCost < rhsCost ? gCost : rhsCost;
+	planner.openSet.Push(cellIndex, minCost + GetDistance(IndexToCell(planner.startIndex), cell) + planner.keyMod, minCost);
+}
+
+//***************
+// UpdateDStarLiteNeighbors
+// D* Lite utility
+// refreshes the cells that may step onto the given cell
+// DEBUG: solid cells are never stepped from, except by an entity overlapping collision at startIndex
+//***************
+void UpdateDStarLiteNeighbors(DStarLite_t & planner, GridCell_t * cell) {
+	for (auto && offset : neighborOffsets) {
+		int row = cell->gridRow + offset.x;
+		int col = cell->gridCol + offset.y;
+		if (row < 0 || row >= gridRows || col < 0 || col >= gridCols)
+			continue;
+
+		int neighborIndex = row * gridCols + col;
+		if (!gameGrid.cells[row][col].solid || neighborIndex == planner.startIndex)
+			UpdateDStarLiteCell(planner, neighborIndex);
+	}
+}
+
+//***************
+// DStarLiteSearch
+// incremental search of gameGrid cells from startCell to goalCell
+// the first search (or any after BakeNavigation) builds a new tree,
+// later ones only repair it for the start moving, the goal moving, and SetCellSolid changes
+// returns false if startCell can't reach goalCell
+//***************
+bool DStarLiteSearch(DStarLite_t & planner, GridCell_t * startCell, GridCell_t * goalCell) {
+	int startIndex = CellIndex(startCell);
+	int goalIndex = CellIndex(goalCell);
+	planner.expansions = 0;
+
+	if (planner.startIndex == -1 || planner.bakes != collisionChanges.bakes) {
+		planner.openSet.Clear();
+		std::fill(planner.gCosts.begin(), planner.gCosts.end(), dstarInfinity);
+		std::fill(planner.rhsCosts.begin(), planner.rhsCosts.end(), dstarInfinity);
+		planner.startIndex = startIndex;
+		planner.lastStart = startIndex;
+		planner.goalIndex = goalIndex;
+		planner.keyMod = 0;
+		planner.changeCursor = collisionChanges.cells.size();
+		planner.bakes = collisionChanges.bakes;
+		planner.rhsCosts[goalIndex] = 0;
+		planner.openSet.Push(goalIndex, GetDistance(startCell, goalCell), 0);
+	} else {
+		// the entity moved, so every queued key's heuristic is off by at most the distance moved
+		if (startIndex != planner.startIndex) {
+			planner.keyMod += GetDistance(IndexToCell(planner.lastStart), startCell);
+			planner.startIndex = startIndex;
+			planner.lastStart = startIndex;
+			UpdateDStarLiteCell(planner, startIndex);
+		}
+
+		// the goal moved, so re-root the tree there
+		if (goalIndex != planner.goalIndex) {
+			int oldGoalIndex = planner.goalIndex;
+			planner.goalIndex = goalIndex;
+			planner.rhsCosts[goalIndex] = 0;
+			UpdateDStarLiteCell(planner, goalIndex);
+			UpdateDStarLiteCell(planner, oldGoalIndex);
+		}
+
+		// collision changed, so re-check the steps onto each changed cell
+		for (; planner.changeCursor < collisionChanges.cells.size(); planner.changeCursor++) {
+			int changedIndex = collisionChanges.cells[planner.changeCursor];
+			UpdateDStarLiteCell(planner, changedIndex);
+			UpdateDStarLiteNeighbors(planner, IndexToCell(changedIndex));
+		}
+	}
+
+	// expand until startCell is consistent and no queued key can improve it
+	OpenSet_t & openSet = planner.openSet;
+	while (!openSet.Empty()) {
+		int startG = planner.gCosts[startIndex];
+		int startRhs = planner.rhsCosts[startIndex];
+		int startMin = startG < startRhs ? startG : startRhs;
+		int topIndex = openSet.Top();
+		int topFCost = openSet.fCosts[topIndex];
+		int topHCost = openSet.hCosts[topIndex];
+		bool topBeforeStart = topFCost < startMin + planner.keyMod || (topFCost == startMin + planner.keyMod && topHCost < startMin);
+		if (!topBeforeStart && startG == startRhs)
+			break;
+
+		// re-key cells queued before keyMod last rose
+		GridCell_t * topCell = IndexToCell(topIndex);
+		int gCost = planner.gCosts[topIndex];
+		int rhsCost = planner.rhsCosts[topIndex];
+		int minCost = gCost < rhsCost ? gCost : rhsCost;
+		int fCost = minCost + GetDistance(startCell, topCell) + planner.keyMod;
+		if (topFCost < fCost || (topFCost == fCost && topHCost < minCost)) {
+			openSet.Update(topIndex, fCost, minCost);
+			continue;
+		}
+
+		openSet.Pop();
+		planner.expansions++;
+		if (gCost > rhsCost) {
+			planner.gCosts[topIndex] = rhsCost;
+		} else {
+			planner.gCosts[topIndex] = dstarInfinity;
+			UpdateDStarLiteCell(planner, topIndex);
+		}
+		UpdateDStarLiteNeighbors(planner, topCell);
+	}
+	return planner.gCosts[startIndex] < dstarInfinity;
+}
+
+//***************
+// DStarLitePath
+// sets path (goal first) by following the lowest cost steps from a searched tree's startIndex
+// returns false if there is no path
+//***************
+bool DStarLitePath(const DStarLite_t & planner, Path_t & path) {
+	path.clear();
+	if (planner.startIndex == -1 || planner.gCosts[planner.startIndex] >= dstarInfinity)
+		return false;
+
+	GridCell_t * cell = IndexToCell(planner.startIndex);
+	path.push_back(cell);
+	while (CellIndex(cell) != planner.goalIndex) {
+		GridCell_t * next = nullptr;
+		int best = dstarInfinity;
+		int cellIndex = CellIndex(cell);
+		for (int edge = navGraph.offsets[cellIndex]; edge < navGraph.offsets[cellIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			int cost = planner.gCosts[step.cell] + step.cost;
+			if (cost < best) {
+				best = cost;
+				next = IndexToCell(step.cell);
+			}
+		}
+
+		// DEBUG: guard against a tree left inconsistent by a missed repair
+		if (next == nullptr || (int)path.size() > gridCellCount) {
+			path.clear();
+			return false;
+		}
+		cell = next;
+		path.push_back(cell);
+	}
+	path.reverse();
+	return true;
+}
+
+//***************
+// ChaseTarget
+// used for dynamic pathfinding
+// keeps the entity headed at its chaseTarget's current cell, see chaseMode
+// by following the shared chaseTree, or repairing its replanner instead of searching from scratch every move
+//***************
+void ChaseTarget(std::shared_ptr<GameObject_t> & entity) {
+	std::shared_ptr<GameObject_t> target = entity->chaseTarget.lock();
+	if (!target || target->health <= 0) {
+		entity->chaseTarget.reset();
+		entity->replanner.reset();
+		entity->path.clear();
+		return;
+	}
+
+	// follow the shared tree, unless the target is out of reach (or the entity is overlapping collision)
+	GridCell_t * startCell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+	if (chaseMode == CHASE_REVERSE_TREE) {
+		UpdateChaseTree(&PointToCell(SDL_Point{ (int)target->center.x, (int)target->center.y }));
+		if (chaseTree.field->goalCell != nullptr && chaseTree.field->costs[CellIndex(startCell)] >= 0) {
+			entity->path.clear();
+			entity->replanner.reset();
+			entity->flowField = chaseTree.field;
+			entity->goal = &chaseTree.field->goalCell->center;
+			return;
+		}
+		entity->flowField.reset();
+	}
+
+	// DEBUG: a target out of reach is chased to the nearest cell that is not
+	GridCell_t * goalCell = NearestReachableCell(startCell, &PointToCell(SDL_Point{ (int)target->center.x, (int)target->center.y }));
+	if (goalCell == nullptr) {
+		entity->path.clear();
+		return;
+	}
+
+	if (!entity->replanner)
+		entity->replanner = std::make_shared<DStarLite_t>();
+
+	// the current path still leads to the target
+	DStarLite_t & planner = *entity->replanner;
+	if (!entity->path.empty() &&
+		planner.goalIndex == CellIndex(goalCell) && 
+		planner.bakes == collisionChanges.bakes &&
+		planner.changeCursor == collisionChanges.cells.size()) {
+		return;
+	}
+
+	entity->goal = &goalCell->center;
+	if (startCell == goalCell) {
+		entity->path.clear();
+		return;
+	}
+
+	if (DStarLiteSearch(planner, startCell, goalCell) && DStarLitePath(planner, entity->path)) {
+		if (anyAnglePaths)
+			SmoothPath(entity->path);
+		entity->onPath = true;
+	}
+}
+
+//***************
+// UpdateBob
+// used for animation
+//***************
+void UpdateBob(std::shared_ptr<GameObject_t> & entity, const Vec2_t & move) {
+	if (entity->health > 0) {
+		bool continueBob = (move.x || move.y);
+		if (continueBob && !entity->bobMaxed) {
+			entity->bobMaxed = (++entity->bob >= 5) ? true : false;
+			entity->origin.y--;
+		} else if (entity->bob > 0) {
+			entity->bobMaxed = (--entity->bob > 0) ? true : false;
+			entity->origin.y++;
+		}
+	}
+}
+
+//***************
+// CheckWaypointRange
+// used for dynamic pathfinding
+// DEBUG: never call with entity->path.empty()
+//***************
+bool CheckWaypointRange(std::shared_ptr<GameObject_t> & entity) {
+	int xRange = SDL_abs((int)(entity->center.x - entity->path.back()->center.x));
+	int yRange = SDL_abs((int)(entity->center.y - entity->path.back()->center.y));
+	return (xRange <= entity->speed && yRange <= entity->speed);
+}
+
+//***************
+// Normalize
+// used for dynamic pathfinding
+//***************
+void Normalize(Vec2_t & v) {
+	float length = SDL_sqrtf(v.x * v.x + v.y * v.y);
+	if (length) {
+		float invLength = 1.0f / length;
+		v.x *= invLength;
+		v.y *= invLength;
+	}
+}
+
+//***************
+// UpdateOrigin
+//***************
+void UpdateOrigin(std::shared_ptr<GameObject_t>  & entity, const Vec2_t & move) {
+	int dx = (int)nearbyintf(move.x);
+	int dy = (int)nearbyintf(move.y);
+
+	entity->origin.x += dx;
+	entity->origin.y += dy;
+	entity->bounds.x += dx;
+	entity->bounds.y += dy;
+	entity->center.x += nearbyintf(move.x);
+	entity->center.y += nearbyintf(move.y);
+	int derp = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// BEGIN FREEHILL flocking test
+/*
+//***************
+// GetGroupAlignment
+// flocking utility
+// calculates the normalized average group velocity
+// TODO(?): weighted average
+//***************
+void GetGroupAlignment(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
+	result = vec2zero;
+	if (!areaContents.size())
+		return;
+
+	float groupCount = 0.0f;
+	for (auto && entity : areaContents) {
+		if (entity->groupID == self->groupID) {
+			result.x += entity->velocity.x;
+			result.y += entity->velocity.y;
+			groupCount++;
+		}
+	}
+
+	if (!groupCount)
+		return;
+
+	result.x /= groupCount;
+	result.y /= groupCount;
+	Normalize(result);
+}
+//***************
+// GetGroupCohesion
+// flocking utility
+// calulates the average group center
+// then a normalized vector towards that center
+//***************
+void GetGroupCohesion(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
+	result = vec2zero;
+	if (!areaContents.size())
+		return;
+
+	float groupCount = 0.0f;
+	for (auto && entity : areaContents) {
+		if (entity->groupID == self->groupID) {
+			result.x += entity->center.x;
+			result.y += entity->center.y;
+			groupCount++;
+		}
+	}
+
+	if (!groupCount)
+		return;
+
+	result.x /= groupCount;
+	result.y /= groupCount;
+	result = { result.x - self->center.x, result.y - self->center.y };
+	Normalize(result);
+}
+
+//***************
+// GetGroupSeparation
+// flocking utility
+// calculates the average separation from group members
+// TODO(?): wieghted average
+//***************
+void GetGroupSeparation(std::vector<std::shared_ptr<GameObject_t>> & areaContents, std::shared_ptr<GameObject_t> & self, Vec2_t & result) {
+	result = vec2zero;
+	if (!areaContents.size())
+		return;
+
+	float groupCount = 0.0f;
+	for (auto && entity : areaContents) {
+		if (entity->groupID == self->groupID) {
+			// FIXME: weigh this based on bounding box size,
+			// not just center-to-center range.
+			result.x += (entity->center.x - self->center.x);
+			result.y += (entity->center.y - self->center.y);
+			groupCount++;
+		}
+	}
+
+	if (!groupCount)
+		return;
+
+	result.x /= -groupCount;
+	result.y /= -groupCount;
+	Normalize(result);
+}
+*/
+// END FREEHILL flocking test
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+//******************
+// Rotate
+// expanded and factored version of:
+// (rotationQuaternion) * quaternionVector( targetX, targetY, 0.0f, 0.0f ) * (rotationQuaternion)^-1
+// assumes a right-handed coordinate system
+// if clockwise == false, it rotates the target values counter-clockwise
+// --only deals with unit length quaternions--
+//******************
+void Rotate(bool clockwise, Vec2_t & result) {
+	static const float ccw[]	= { 0.0f, 0.0f, SDL_sinf(DEG2RAD(1.0f) / 2.0f), SDL_cosf(DEG2RAD(1.0f) / 2.0f) };
+	static const float cw[]		= { 0.0f, 0.0f, SDL_sinf(DEG2RAD(-1.0f) / 2.0f), SDL_cosf(DEG2RAD(-1.0f) / 2.0f) };
+
+	const float * r;
+	if (clockwise)
+		r = cw;
+	else
+		r = ccw;
+
+	float xxzz = r[0]*r[0] - r[2]*r[2];
+	float wwyy = r[3]*r[3] - r[1]*r[1];
+
+	float xy2 = r[0]*r[1]*2.0f;
+	float zw2 = r[2]*r[3]*2.0f;
+
+	float oldX = result.x;
+	float oldY = result.y;
+
+	result = {	(xxzz + wwyy)*oldX + (xy2 - zw2)*oldY,
+				(xy2 + zw2)*oldX + (r[1]*r[1] + r[3]*r[3] - r[0]*r[0] - r[2]*r[2])*oldY };
+}
+
+//***************
+// Maximize
+//***************
+float Maximize(const float & a, const float & b) {
+	return a > b ? a : b;
+}
+
+//***************
+// Minimize
+//***************
+float Minimize(const float & a, const float & b) {
+	return a < b ? a : b;
+}
+
+//***************
+// GetSurfaceNormal
+// DEBUG: disregards collision
+//***************
+Vec2_t GetSurfaceNormal(const SDL_Rect & a, const SDL_Rect & b, const Vec2_t & va, const Vec2_t & vb) {
+	Vec2_t normal = vec2zero;
+	Vec2_t aMin = { (float)a.x, (float)a.y };
+	Vec2_t aMax = { (float)(a.x + a.w), (float)(a.y + a.h) };
+	Vec2_t bMin = { (float)b.x, (float)b.y };
+	Vec2_t bMax = { (float)(b.x + b.w), (float)(b.y + b.h) };
+	Vec2_t relativeV = va - vb;
+
+	for (int i = 0; i < 2; i++) {
+		if (relativeV[i] <= 0.0f) {
+//			if (aMax[i] < bMin[i]) /* does nothing, yet */;
+			if (bMax[i] <= aMin[i]) normal[i] = 1.0f;
+//			if (aMax[i] > bMin[i])	/* does nothing, yet */;
+		}
+		if (relativeV[i] > 0.0f) {
+//			if (aMin[i] > bMax[i]) /* does nothing, yet */;
+			if (aMax[i] <= bMin[i]) normal[i] = -1.0f;
+//			if (bMax[i] > aMin[i]) /* does nothing, yet */;
+		}
+	}
+	return normal;
+}
+
+//***************
+// TranslateRect
+// dynamic pathfinding utility
+//***************
+SDL_Rect TranslateRect(const SDL_Rect & src, const Vec2_t translation) {
+	return SDL_Rect {	(int)nearbyintf(src.x + translation.x), 
+						(int)nearbyintf(src.y + translation.y), 
+						src.w, 
+						src.h };
+}
+
+
+//***************
+// BroadPhaseAABB
+// dynamic pathfinding utility
+// Broad-phase moving AABB-AABB collision test utility
+//***************
+SDL_Rect GetBroadPhaseAABB(std::shared_ptr<GameObject_t> & entity) {
+	SDL_Rect bpAABB;
+	Vec2_t sweep = entity->velocity * entity->speed;
+	bpAABB.x = entity->velocity.x > 0.0f ? entity->bounds.x : (int)nearbyintf(entity->bounds.x + sweep.x);
+	bpAABB.y = entity->velocity.y > 0.0f ? entity->bounds.y : (int)nearbyintf(entity->bounds.y + sweep.y);
+	bpAABB.w = entity->velocity.x > 0.0f ? (int)nearbyintf(entity->bounds.w + sweep.x) : (int)nearbyintf(entity->bounds.w - sweep.x);
+	bpAABB.h = entity->velocity.y > 0.0f ? (int)nearbyintf(entity->bounds.h + sweep.y) : (int)nearbyintf(entity->bounds.h - sweep.y);
+	return bpAABB;
+}
+
+//***************
+// AABBAABBTest
+// dynamic pathfinding utility
+// AABB-AABB collision test
+// DEBUG: includes touching
+// returns true in the case of intersection
+//***************
+bool AABBAABBTest(const SDL_Rect & a, const SDL_Rect & b) {
+	int t;
+	// if((t = a.x - b.x) == b.w || -t == a.w) return true; (confirms touching in x)
+	// if((t = a.y - b.y) == b.h || -t == a.h) return true; (confirms touching in y)
+
+	if ((t = a.x - b.x) > b.w || -t > a.w) return false;
+	if ((t = a.y - b.y) > b.h || -t > a.h) return false;
+	return true;
+}
+
+//***************
+// MovingAABBAABBTest
+// dynamic pathfinding utility
+// AABB-AABB collision test where ONE is moving
+// returns true if already in collision
+// returns false if no collision will occur
+// otherwise returns the fraction along the movement
+// where collision first occurs
+//***************
+bool MovingAABBAABBTest(const SDL_Rect & a, const SDL_Rect & b, const Vec2_t & va, const Vec2_t & vb, Vec2_t & times) {
+
+	// started in collision
+	if (AABBAABBTest(a, b)) {
+		times = vec2zero;
+		return true;
+	}
+
+	// FIXME/BUG: the collision normal is not computed if the entity walked exactly up to the obstacle as to touch it this frame
+	// then NEXT frame its right on it, so NONE of the if conditions execute
+
+	Vec2_t aMin = { (float)a.x, (float)a.y };
+	Vec2_t aMax = { (float)(a.x + a.w), (float)(a.y + a.h) };
+	Vec2_t bMin = { (float)b.x, (float)b.y };
+	Vec2_t bMax = { (float)(b.x + b.w), (float)(b.y + b.h) };
+	Vec2_t relativeV = va;// -vb;		// FIXME/DEBUG: fully kinematic simulation with non-simultaneous motion doesn't need relative velocity
+	times.x = 0.0f;	// DEBUG: tFirst
+	times.y = 1.0f;	// DEBUG: tLast
+
+	// determine times of first and last contact, if any
+	for (int i = 0; i < 2; i++) {
+		if (relativeV[i] < 0.0f) {
+			if (aMax[i] < bMin[i]) return false; // non-intersecting and moving apart
+			if (bMax[i] < aMin[i]) times.x = Maximize((bMax[i] - aMin[i]) / relativeV[i], times.x);
+			if (aMax[i] > bMin[i]) times.y = Minimize((bMin[i] - aMax[i]) / relativeV[i], times.y);
+		}
+		if (relativeV[i] > 0.0f) {
+			if (aMin[i] > bMax[i]) return false; // non-intersecting and moving apart
+			if (aMax[i] < bMin[i]) times.x = Maximize((bMin[i] - aMax[i]) / relativeV[i], times.x);
+			if (bMax[i] > aMin[i]) times.y = Minimize((bMax[i] - aMin[i]) / relativeV[i], times.y);
+		}
+		
+		// generally, too far away to make contact
+		// DEBUG: if tFirst == tLast == 1.0f then this function returns true (a collision will occur)
+		// however, tFirst can also wind up as 0.0f but this function returns false, so tFirst ISN'T the final decider of collision
+		if (times.x > times.y)
+			return false;
+	}
+	return true;
+}
+
+//***************
+// CheckPathCell
+// used for dynamic pathfinding
+// DEBUG: never call this function with an empty path
+//***************
+void CheckPathCell(std::shared_ptr<GameObject_t> & entity) {
+	if (entity->onPath && !AABBAABBTest(entity->bounds, entity->path.back()->bounds)) {	
+		entity->onPath = false;
+		entity->path.pop_back();										
+	}
+
+	if (!entity->path.empty() && AABBAABBTest(entity->bounds, entity->path.back()->bounds)) {
+		entity->onPath = true;
+	}
+}
+
+//***************
+// FollowFlowField
+// used for dynamic pathfinding
+// heads towards the next flow field cell from the entity's current cell
+// drops the flow field once at its goal, or if the goal can't be reached
+// DEBUG: never call this function without a flowField
+//***************
+void FollowFlowField(std::shared_ptr<GameObject_t> & entity) {
+	GridCell_t * cell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+	GridCell_t * target = (cell == entity->flowField->goalCell) ? cell : entity->flowField->Next(cell);
+
+	// leave the field for the entity's own goal slot once as close to the field's goal, see AssignGoalSlots
+	// DEBUG: chasers share a field whose goalCell moves, so they have no slot
+	bool slotted = entity->goal != nullptr && entity->chaseTarget.expired();
+	GridCell_t * slotCell = slotted ? &PointToCell(*entity->goal) : entity->flowField->goalCell;
+	int slotCost = entity->flowField->costs[CellIndex(slotCell)];
+	if (slotCell != entity->flowField->goalCell && slotCost >= 0 && entity->flowField->costs[CellIndex(cell)] <= slotCost) {
+		entity->flowField.reset();
+		if (!PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, *entity->goal))
+			entity->velocity = vec2zero;
+		return;
+	}
+
+	if (target == nullptr) {
+		entity->flowField.reset();
+		entity->velocity = vec2zero;
+		return;
+	}
+
+	Vec2_t waypointVec = {	(float)target->center.x - entity->center.x,
+							(float)target->center.y - entity->center.y	};
+
+	if (target == entity->flowField->goalCell && 
+		SDL_abs((int)waypointVec.x) <= entity->speed && 
+		SDL_abs((int)waypointVec.y) <= entity->speed) {
+		entity->flowField.reset();
+		entity->velocity = vec2zero;
+		return;
+	}
+
+	Normalize(waypointVec);
+	entity->velocity = waypointVec;
+}
+
+//***************
+// FollowReservation
+// used for dynamic pathfinding
+// heads towards the entity's reserved cell for the next tick, or holds still while waiting
+// replans halfway through the window, and drops the order once at the goal or stuck short of it
+// DEBUG: never call this function without reservedCells and a flowField
+//***************
+void FollowReservation(std::shared_ptr<GameObject_t> & entity) {
+	GridCell_t * cell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+	Uint32 step = reservationTable.now - entity->reservedTick;
+
+	if (step >= reservationWindow / 2) {
+		if (!ReserveCooperativePath(entity, cell)) {
+			ReleaseReservations(entity);
+			entity->reservedCells.clear();
+			entity->flowField.reset();
+			entity->velocity = vec2zero;
+			return;
+		}
+		step = 0;
+	}
+
+	GridCell_t * target = entity->reservedCells[step + 1];
+	Vec2_t waypointVec = {	(float)target->center.x - entity->center.x,
+							(float)target->center.y - entity->center.y	};
+
+	if (SDL_abs((int)waypointVec.x) <= entity->speed && SDL_abs((int)waypointVec.y) <= entity->speed) {
+		if (target == entity->flowField->goalCell) {
+			ReleaseReservations(entity);
+			entity->reservedCells.clear();
+			entity->flowField.reset();
+		}
+		entity->velocity = vec2zero;		// waiting, or ahead of schedule
+		return;
+	}
+
+	Normalize(waypointVec);
+	entity->velocity = waypointVec;
+}
+
+//***************
+// FormationHeading
+// used for dynamic pathfinding
+// unit direction along a GROUPMOVE_FORMATION leader's path from its current waypoint to the next, the forward axis of its formation
+// or to its last waypoint from where it stands
+// DEBUG: measured along the path, so a leader jostled past its current waypoint doesn't turn its formation around,
+// and a leader already on its last waypoint faces +x
+//***************
+Vec2_t FormationHeading(const GameObject_t & leader) {
+	Vec2_t heading = vec2zero;
+	Vec2_t from = leader.path.size() >= 2 ? Vec2_t{ (float)leader.path.back()->center.x, (float)leader.path.back()->center.y } : leader.center;
+	for (auto waypoint = leader.path.rbegin(); waypoint != leader.path.rend() && heading == vec2zero; ++waypoint)
+		heading = Vec2_t{ (float)(*waypoint)->center.x, (float)(*waypoint)->center.y } - from;
+
+	if (heading == vec2zero)
+		return Vec2_t{ 1.0f, 0.0f };
+	Normalize(heading);
+	return heading;
+}
+
+//***************
+// FollowLeader
+// used for dynamic pathfinding
+// heads for the entity's formation spot behind or beside its moving leader, keeping clear of nearby members of its groupID
+// falls in behind the leader if the spot is blocked or out of sight, or heads along its trail once the leader is out of sight too
+// hands off to its own PathFind to its goal once the leader is as near its goal as the spot is to the leader,
+// or early if it loses sight of the trail as well
+// takes the lead if it's ahead of the leader while the leader stays stuck for formationJamSteps,
+// leaving the old leader its spot and the rest of the formation to follow along to the new leader
+// the leader slows to half its pace while any follower that isn't stuck lags well behind its spot
+// DEBUG: never call this function without a leader, followers of a removed leader just stop
+//***************
+void FollowLeader(std::shared_ptr<GameObject_t> & entity, const AreaContents_t & contents) {
+	std::shared_ptr<GameObject_t> leader = entity->leader.lock();
+
+	// the leader may have handed the formation on
+	while (leader->path.empty() && !leader->leader.expired()) {
+		entity->trail = leader->trail;
+		leader = leader->leader.lock();
+		entity->leader = leader;
+	}
+
+	GridCell_t * cell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+	GridCell_t * leaderCell = &PointToCell(SDL_Point{ (int)leader->center.x, (int)leader->center.y });
+	entity->velocity = vec2zero;
+
+	Vec2_t heading = FormationHeading(*leader);
+	Vec2_t side = { -heading.y, heading.x };
+	Vec2_t offset = heading * entity->formationOffset.x + side * entity->formationOffset.y;
+
+	// the last stretch is the entity's own order
+	// DEBUG: leader paths may be smoothed to a few waypoints, so this uses the leader's straight distance to its goal
+	float spotRange = SDL_sqrtf(entity->formationOffset * entity->formationOffset) * 10.0f / cellSize;
+	if (leader->path.empty() || GetDistance(leaderCell, &PointToCell(*leader->goal)) <= spotRange + 10.0f) {
+		entity->leader.reset();
+		entity->trail.reset();
+		PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, *entity->goal);
+		return;
+	}
+
+	// a follower ahead of a jammed leader is likely in its way, so it leads the formation on instead
+	// DEBUG: one PathFind per jam, the rest of the formation keeps following
+	if (leader->stuckSteps >= formationJamSteps && (entity->center - leader->center) * heading > 0.0f && 
+		PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, *entity->goal)) {
+		entity->trail = std::make_shared<Path_t>(entity->path);
+		entity->trail->push_back(cell);
+		leader->path.clear();
+		leader->leader = entity;
+		leader->trail = entity->trail;
+		leader->formationOffset = entity->formationOffset;
+		leader->stuckSteps = 0;
+		entity->leader.reset();
+		entity->trail.reset();
+		return;
+	}
+
+	Vec2_t spot = leader->center + offset;
+	GridCell_t * spotCell = &PointToCell(SDL_Point{ (int)spot.x, (int)spot.y });
+	bool trailing = false;
+	if (spot.x < 0.0f || spot.x >= gameWidth || spot.y < 0.0f || spot.y >= gameHeight || spotCell->solid || !LineOfSight(cell, spotCell)) {
+		if (LineOfSight(cell, leaderCell)) {
+			// DEBUG: hold short of the leader, so it isn't crowded
+			spot = leader->center;
+			Vec2_t leaderVec = spot - entity->center;
+			if (leaderVec * leaderVec <= formationSpacing * formationSpacing)
+				return;
+		} else {
+			// the trail waypoint in sight nearest the leader
+			GridCell_t * waypoint = nullptr;
+			for (auto && trailCell : *entity->trail) {
+				if ((waypoint == nullptr || GetDistance(trailCell, leaderCell) < GetDistance(waypoint, leaderCell)) && LineOfSight(cell, trailCell))
+					waypoint = trailCell;
+			}
+
+			// lost, so the rest of the way is the entity's own order too
+			if (waypoint == nullptr) {
+				entity->leader.reset();
+				entity->trail.reset();
+				PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, *entity->goal);
+				return;
+			}
+			spot = Vec2_t{ (float)waypoint->center.x, (float)waypoint->center.y };
+			trailing = true;
+		}
+	}
+
+	// DEBUG: a follower that's stuck doesn't hold up the rest of the group
+	Vec2_t spotVec = spot - entity->center;
+	if ((trailing || spotVec * spotVec > 4 * formationSpacing * formationSpacing) && entity->stuckSteps == 0)
+		leader->followersLagging = true;
+
+	// in place, keep pace
+	if (SDL_abs((int)spotVec.x) <= entity->speed && SDL_abs((int)spotVec.y) <= entity->speed) {
+		entity->velocity = leader->velocity;
+		return;
+	}
+	Normalize(spotVec);
+
+	// separation, stronger the closer the groupmate
+	Vec2_t separation = vec2zero;
+	for (auto && other : contents.entities) {
+		if (other->groupID != entity->groupID || other == leader)
+			continue;
+
+		Vec2_t away = entity->center - other->center;
+		float range = SDL_sqrtf(away * away);
+		if (range > 0.0f && range < formationSpacing)
+			separation += away * ((formationSpacing - range) / (formationSpacing * range));
+	}
+
+	entity->velocity = spotVec + separation;
+	Normalize(entity->velocity);
+}
+
+//***************
+// FlowFieldCrowded
+// used for dynamic pathfinding
+// true if every cell between the entity and its flow field goal is occupied by others
+// DEBUG: never call this function without a flowField
+//***************
+bool FlowFieldCrowded(std::shared_ptr<GameObject_t> & entity) {
+	GridCell_t * cell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+	while (cell != nullptr) {
+		if (EMPTY_EXCEPT_SELF((*cell), entity))
+			return false;
+		cell = entity->flowField->Next(cell);
+	}
+	return true;
+}
+
+//***************
+// CellBlocked
+// used for dynamic pathfinding
+// true if a unit other than the entity is standing still in the cell
+//***************
+bool CellBlocked(const GridCell_t & cell, const std::shared_ptr<GameObject_t> & entity) {
+	for (auto && other : cell.contents) {
+		if (other->guid != entity->guid && other->type != OBJECTTYPE_MISSILE && other->velocity == vec2zero)
+			return true;
+	}
+	return false;
+}
+
+//***************
+// StepTowards
+// RepairPath utility
+// the neighbor of cell closest to the line from lineStart to lineEnd, one step nearer lineEnd
+// DEBUG: walks the cells between the waypoints of any-angle paths
+//***************
+GridCell_t * StepTowards(const GridCell_t * cell, const GridCell_t * lineStart, const GridCell_t * lineEnd) {
+	int dRow = Sign(lineEnd->gridRow - cell->gridRow);
+	int dCol = Sign(lineEnd->gridCol - cell->gridCol);
+	int lineRows = lineEnd->gridRow - lineStart->gridRow;
+	int lineCols = lineEnd->gridCol - lineStart->gridCol;
+
+	int bestRow = cell->gridRow + dRow;
+	int bestCol = cell->gridCol + dCol;
+	int bestError = INT_MAX;
+	const SDL_Point steps[3] = { { dRow, dCol }, { dRow, 0 }, { 0, dCol } };
+	for (auto && step : steps) {
+		if (step.x == 0 && step.y == 0)
+			continue;
+
+		int row = cell->gridRow + step.x;
+		int col = cell->gridCol + step.y;
+		int error = SDL_abs((row - lineStart->gridRow) * lineCols - (col - lineStart->gridCol) * lineRows);
+		if (error < bestError) {
+			bestError = error;
+			bestRow = row;
+			bestCol = col;
+		}
+	}
+	return &gameGrid.cells[bestRow][bestCol];
+}
+
+//***************
+// RepairPath
+// used for dynamic pathfinding
+// if stationary units block any of the next repairLookahead cells along the entity's path,
+// searches a small box around them for a detour to the first clear cell past them,
+// and splices it onto the rest of the path
+// returns false if the path is clear, or couldn't be repaired locally
+// DEBUG: only blocks the cells of units standing still, moving units are left to AvoidCollision
+//***************
+bool RepairPath(std::shared_ptr<GameObject_t> & entity, SearchContext_t & context = mainSearchContext) {
+	static thread_local std::vector<std::pair<GridCell_t *, int>> ahead;		// cell, and the path index of the waypoint it leads to
+	static thread_local Path_t detour;
+
+	Path_t & path = entity->path;
+	if (!localPathRepair || !entity->onPath || path.size() < 2)
+		return false;
+
+	// walk the cells ahead, including those between the waypoints of any-angle paths
+	ahead.clear();
+	GridCell_t * cell = path.back();
+	for (int waypoint = path.size() - 2; waypoint >= 0 && (int)ahead.size() < repairLookahead + repairRejoin; ) {
+		cell = StepTowards(cell, path[waypoint + 1], path[waypoint]);
+		if (cell == path[waypoint])
+			waypoint--;
+		ahead.push_back({ cell, waypoint + (cell == path[waypoint + 1] ? 1 : 0) });
+	}
+
+	int blocked = 0;
+	while (blocked < (int)ahead.size() && blocked < repairLookahead && !CellBlocked(*ahead[blocked].first, entity))
+		blocked++;
+	if (blocked == (int)ahead.size() || blocked == repairLookahead)
+		return false;
+
+	// DEBUG: the cells walked between any-angle waypoints only approximate the line, so the rejoin cell must see its waypoint
+	int unitRadius = PathUnitRadius(*entity);
+	int rejoin = blocked + 1;
+	while (rejoin < (int)ahead.size() && (CellBlocked(*ahead[rejoin].first, entity) || 
+			!LineOfSight(ahead[rejoin].first, path[ahead[rejoin].second], unitRadius < 0 ? 0 : unitRadius))) {
+		rejoin++;
+	}
+	if (rejoin == (int)ahead.size())
+		return false;		// DEBUG: crowded all the way to the goal, wait
+
+	// box the search around the blockage, closing the blocked cells within it
+	GridCell_t * startCell = path.back();
+	GridCell_t * rejoinCell = ahead[rejoin].first;
+	int minRow = (startCell->gridRow < rejoinCell->gridRow ? startCell->gridRow : rejoinCell->gridRow) - repairMargin;
+	int minCol = (startCell->gridCol < rejoinCell->gridCol ? startCell->gridCol : rejoinCell->gridCol) - repairMargin;
+	int maxRow = (startCell->gridRow > rejoinCell->gridRow ? startCell->gridRow : rejoinCell->gridRow) + repairMargin;
+	int maxCol = (startCell->gridCol > rejoinCell->gridCol ? startCell->gridCol : rejoinCell->gridCol) + repairMargin;
+	minRow = minRow < 0 ? 0 : minRow;
+	minCol = minCol < 0 ? 0 : minCol;
+	maxRow = maxRow >= gridRows ? gridRows - 1 : maxRow;
+	maxCol = maxCol >= gridCols ? gridCols - 1 : maxCol;
+	SDL_Rect bounds = { minRow, minCol, maxRow - minRow + 1, maxCol - minCol + 1 };
+
+	context.Reset();
+	context.unitRadius = unitRadius;
+	for (int row = minRow; row <= maxRow; row++) {
+		for (int col = minCol; col <= maxCol; col++) {
+			GridCell_t & boxCell = gameGrid.cells[row][col];
+			if (&boxCell != startCell && &boxCell != rejoinCell && CellBlocked(boxCell, entity))
+				context.Close(CellIndex(&boxCell));
+		}
+	}
+
+	if (!AStarSearch(context, startCell, rejoinCell, &bounds))
+		return false;
+	BuildPath(context, CellIndex(rejoinCell), detour);
+
+	// keep the path up to the waypoint past rejoinCell, then the detour back to startCell
+	int waypoint = ahead[rejoin].second;
+	while ((int)path.size() > waypoint + 1)
+		path.pop_back();
+	if (path.back() == rejoinCell)
+		path.pop_back();
+	for (auto && detourCell : detour)
+		path.push_back(detourCell);
+	return true;
+}
+
+//***************
+// AvoidCongestion
+// used for dynamic pathfinding
+// replans a group order stuck for congestionReplanSteps as the entity's own PathFind,
+// charging congestionCost per unit in each cell, so it can take an alternate route around the jam
+// DEBUG: GROUPMOVE_FORMATION followers wait on their leader instead, see FollowLeader
+// DEBUG: drops a shared flowField, since the rest of the group may still be moving along it
+//***************
+void AvoidCongestion(std::shared_ptr<GameObject_t> & entity) {
+	entity->stuckSteps = 0;
+	if (entity->goal == nullptr || !entity->chaseTarget.expired() || !entity->reservedCells.empty() || !entity->leader.expired())
+		return;
+
+	Path_t oldPath = entity->path;
+	mainSearchContext.congestion = congestionCost;
+	bool found = PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, *entity->goal);
+	mainSearchContext.congestion = 0;
+	if (found)
+		entity->flowField.reset();
+	else
+		entity->path = oldPath;
+}
+
+//***************
+// CheckForwardCollision
+// returns the fraction along the current velocity where
+// touching first occurs between self and 
+// local entities or static obstacles, if any
+// DEBUG: never returns 0.0f which implies two things started in overlap/touching
+// sets the collision entity, if any
+// otherwise sets the collision entity to nullptr
+//***************
+float CheckForwardCollision(std::shared_ptr<GameObject_t> & self, const AreaContents_t & contents, std::shared_ptr<GameObject_t> & collisionEntity) {
+
+	float nearest = 1.0f;
+	const Vec2_t selfMove = self->velocity * self->speed;
+	SDL_Rect broadPhaseBounds = GetBroadPhaseAABB(self);
+	SDL_Rect nextSelfBounds = TranslateRect(self->bounds, selfMove);
+
+	// entity check
+	collisionEntity.reset();
+	for (auto && entity : contents.entities) {
+
+		// broad-phase test first,
+		// then so a swept AABB test on the next n steps
+		Vec2_t times;
+		if (AABBAABBTest(broadPhaseBounds, entity->bounds) &&
+			MovingAABBAABBTest(nextSelfBounds, entity->bounds, selfMove, entity->velocity * entity->speed, times)) {
+
+			// DEBUG: don't even consider a move along a vector with ANY collision
+			collisionEntity = entity;
+			nearest = 0.0f;
+			break;
+		}
+	}
+
+	// static obstacle check
+	for (auto && obstacle : contents.obstacles) {
+
+		// broad-phase test first
+		// then so a swept AABB test on the next n steps
+		Vec2_t times;
+		if (AABBAABBTest(broadPhaseBounds, *obstacle) && 
+			MovingAABBAABBTest(nextSelfBounds, *obstacle, selfMove, { 0.0f, 0.0f }, times)) {
+				collisionEntity.reset();
+				nearest = 0.0f;
+				break;
+		}
+	}
+	return nearest;
+}
+
+//***************
+// AvoidCollision
+// dynamic pathfinding utility
+// updates current velocity to avoid predicted collisions
+// with all area contents (dynamic and static obstacles)
+// returns the maximum fraction along any forward velocity
+// before that avoids all collision
+//***************
+float AvoidCollision(std::shared_ptr<GameObject_t> & self, const AreaContents_t & contents) {
+	static std::shared_ptr<GameObject_t> collisionEntity;
+
+	avoidanceSweeps++;
+
+	Vec2_t desiredVelocity = self->velocity;
+
+	// rotated 90 degrees CCW to setup for the 180 degree CW sweep
+	self->velocity = { -self->velocity.y, self->velocity.x };
+
+	float bestWeight = 0.0f;
+	float bestFraction = 0.0f;
+	Vec2_t bestVelocity = vec2zero;
+
+	// check a 180 degree forward arc maximizing movement along path
+	for (int angle = 0; angle < 180; angle++) {
+		Rotate(CLOCKWISE, self->velocity);
+		float fraction = CheckForwardCollision(self, contents, collisionEntity);	// DEBUG: forced to either 0.0f or 1.0f
+		float weight = (self->velocity * desiredVelocity);
+
+		if (fraction > bestFraction || (fraction == bestFraction && weight > bestWeight)) {
+			bestWeight = weight;
+			bestFraction = fraction;
+			bestVelocity = self->velocity;
+		}
+	}
+	self->velocity = bestVelocity;
+	return bestFraction;
+}
+
+//***************
+// Collide
+// collision response called by the sender
+// TODO: possibly invoke this during Move
+//***************
+void Collide(std::shared_ptr<GameObject_t> & sender, std::shared_ptr<GameObject_t> & receiver) {
+	//	entities[1]->blinkTime = SDL_GetTicks() + 1000;
+	//	entities[1]->damaged = true;
+	//	entities[1]->health = -10;
+}
+
+//***************
+// Walk
+// dynamic pathfinding
+//***************
+void Walk(std::shared_ptr<GameObject_t> & entity) {
+	static AreaContents_t areaContents;						// fetched and used once per frame per entity, then cleared
+
+	Uint32 dt = SDL_GetTicks() - entity->moveTime;
+
+	if (dt >= 25) {
+		entity->moveTime = SDL_GetTicks();
 
 // BEGIN FREEHILL path cell traversal and update test
 /*		
@@ -1622,238 +5157,1858 @@ void Walk(std::shared_ptr<GameObject_t> & entity) {
 					// DEBUG: ignore the entity itself as part of the cell contents check
 					if (EMPTY_EXCEPT_SELF((**cell), entity)) {
 						continue;
-					} else {	// re-path to the goal
-						pathChanged = PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, entity->goal);
+					} else {	// re-path to the goal
+						pathChanged = PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, entity->goal);
+					}
+					if (pathChanged || entity->path.empty())	// DEBUG: changing the path invalidates this loop's iterators
+						break;
+				}
+			} while (pathChanged && !entity->path.empty());
+*/
+// END FREEHILL path cell traversal and update test
+
+		// determine optimal unit-velocity and speed 
+		Vec2_t move = vec2zero;
+
+		if (!entity->path.empty() || entity->flowField || !entity->leader.expired()) {
+
+			// head towards last waypoint if off-path,
+			// otherwise use the local gradient
+			// (or the flow field or leader, for group orders)
+			if (!entity->flowField && !entity->path.empty())
+				CheckPathCell(entity);
+			areaContents.Update(entity->center, entity);
+
+///////////////////////////////////////////////////////////////////////////
+// BEGIN FREEHILL yielding cooperation test
+	// DEBUG: path.empty() may be true here because of CheckCellPath(entity)
+	// 1) yield to a collision entity (ie the closest one during CheckForwardCollision)....maybe
+	// 2) ???
+	// 3) profit.
+// END FREEHILL yielding cooperation test
+///////////////////////////////////////////////////////////////////////////
+
+			if (!entity->reservedCells.empty()) {
+				FollowReservation(entity);
+			} else if (entity->flowField) {
+				FollowFlowField(entity);
+			} else if (entity->path.empty() && !entity->leader.expired()) {
+				FollowLeader(entity, areaContents);
+			} else if (entity->onPath && entity->path.size() >= 2) {
+				RepairPath(entity);
+				auto & from = entity->path.at(entity->path.size() - 1)->center;
+				auto & to = entity->path.at(entity->path.size() - 2)->center;
+				Vec2_t localGradient = { (float)(to.x - from.x), (float)(to.y - from.y) };
+				Normalize(localGradient);
+				entity->velocity = localGradient;
+			} else if (!entity->path.empty()) {	// !entity->onPath || entity->path.size() < 2
+				// FIXME/BUG: check if the path is empty again here
+				// ...or change CheckPathCell to not pop_back a waypoint
+				auto & currentWaypoint = entity->path.back()->center;
+				if (!CheckWaypointRange(entity)) {
+					Vec2_t waypointVec = {	(float)(currentWaypoint.x - entity->center.x),
+											(float)(currentWaypoint.y - entity->center.y)	};
+					Normalize(waypointVec);
+					entity->velocity = waypointVec;
+				} else {
+					entity->path.pop_back();
+					entity->velocity = vec2zero;
+				}
+			}
+									
+// BEGIN FREEHILL flocking test
+/*
+			// FIXME: dont use specific waypoints because entities wind up jostling for the same waypoint
+			// FIXME: these steering forces need to be better balanced so they dont cancel eachother out all the time
+			// FIXME: using this with gradient velocities throws entities off the end of the trail infinitely (until given a new path)
+			Vec2_t alignment, cohesion, separation;
+			GetGroupAlignment(areaEntities, entity, alignment);
+			GetGroupCohesion(areaEntities, entity, cohesion);
+			GetGroupSeparation(areaEntities, entity, separation);
+			entity->velocity +=  separation + alignment + cohesion;
+			Normalize(entity->velocity);
+*/
+// END FREEHILL flocking test
+
+			// a GROUPMOVE_FORMATION leader lets its followers catch up at half its pace, see FollowLeader
+			bool waiting = entity->followersLagging && !entity->waitedLastStep;
+			entity->followersLagging = false;
+			entity->waitedLastStep = waiting;
+			if (waiting)
+				entity->velocity = vec2zero;
+
+			// stop moving if the path is crowded
+			std::shared_ptr<GameObject_t> collisionEntity;
+			float fraction = CheckForwardCollision(entity, areaContents, collisionEntity);
+			if (fraction < 1.0f && collisionEntity) {
+				if (collisionEntity->velocity == vec2zero) {
+					// FIXME: occasional perma-bob vibrator due to clear path but obstructed velocity
+					// (collision check doesn't quite fix this)
+					bool pathCrowded = entity->flowField ? FlowFieldCrowded(entity) 
+														: std::find_if(	entity->path.begin(), 
+																		entity->path.end(),
+																		[&entity](auto && cell) { 
+																			return EMPTY_EXCEPT_SELF((*cell), entity);	// cell->contents.empty();
+																	}) == entity->path.end();
+					if (pathCrowded) { 
+						entity->velocity = vec2zero;
+					}
+				}
+			}
+
+			// pick a different trajectory if there's no way forward
+			// FIXME/BUG: because fraction reported is always > 0.0f the entity will always move
+			// which is probably why the entity walks straight into others (totally overlapping)
+			// FIXME: AvoidCollision() sets the velocity regardless of the fraction
+			// however fraction SHOULD stop it if its 0.0f (note: not the main issue)
+			// DEBUG: a clear way forward needs no sweep
+			if (entity->velocity != vec2zero && fraction < 1.0f)
+				fraction = AvoidCollision(entity, areaContents);
+			move = entity->velocity * entity->speed * fraction;// *((float)frameTime / 1000.0f);
+			UpdateOrigin(entity, move);
+
+			// DEBUG: a waiting leader is neither stuck nor moving, so it still replans if blocked on the steps between
+			if (!waiting)
+				entity->stuckSteps = (move.x || move.y) ? 0 : entity->stuckSteps + 1;
+			if (congestionCosts && entity->stuckSteps >= congestionReplanSteps)
+				AvoidCongestion(entity);
+		}
+
+		// if the entity moved, then update gameGrid and internal cell lists for collision filtering
+		if (move.x || move.y)
+			UpdateCellReferences(entity);
+
+		UpdateBob(entity, move);		// DEBUG: bob does not affect cell location
+	}
+	areaContents.Clear();
+}
+
+//***************
+// Fly
+// linear movement
+//***************
+void Fly(std::shared_ptr<GameObject_t> & entity) {
+	Uint32 dt = SDL_GetTicks() - entity->moveTime;
+
+	if (dt >= 25) {
+		entity->moveTime = SDL_GetTicks();
+		Vec2_t move = entity->velocity * entity->speed;
+		UpdateOrigin(entity, move);
+		UpdateCellReferences(entity);
+		UpdateBob(entity, move);		// DEBUG: bob does not affect cell location
+	}
+}
+
+//***************
+// GoodmanThink
+//***************
+void GoodmanThink(std::shared_ptr<GameObject_t> & entity) {
+	// TODO: Goodman's strategy/state here
+	Walk(entity);
+}
+
+//***************
+// MeleeThink
+// TODO: master EntityThink() function calls this based on entity type
+//***************
+void MeleeThink(std::shared_ptr<GameObject_t> & entity) {
+	// TODO: resolve standing orders
+	if (!entity->chaseTarget.expired())
+		ChaseTarget(entity);
+	Walk(entity);
+}
+
+//***************
+// RangedThink
+//***************
+void RangedThink(std::shared_ptr<GameObject_t> & entity) {
+	// TODO: resolve standing orders
+	Walk(entity);
+}
+
+//***************
+// MissileThink
+//***************
+void MissileThink(std::shared_ptr<GameObject_t> & entity) {
+	Fly(entity);
+//	if (CheckLocalCollision(entity, nullptr)) {
+		// TODO: only do damage to goodman
+		// TODO: explode no matter  (begin explosion animation and sound)
+	//	RemoveEntity(entity);
+//	}
+}
+
+//***************
+// Think
+// master GameObject_t think function
+//***************
+void Think() {
+	reservationTable.now = SDL_GetTicks() / reservationTickMS;
+
+	for (auto && entity : entities) {
+		switch (entity->type) {
+			case OBJECTTYPE_GOODMAN: GoodmanThink(entity);  break;
+			case OBJECTTYPE_MELEE: MeleeThink(entity);  break;
+			case OBJECTTYPE_RANGED: RangedThink(entity);  break;
+		}
+	}
+
+	for (auto && missile : missiles)
+		MissileThink(missile);
+}
+
+//***************
+// CancelOrder
+// drops whatever the entity was last ordered to do
+//***************
+void CancelOrder(std::shared_ptr<GameObject_t> & entity) {
+	ReleaseReservations(entity);
+	entity->reservedCells.clear();
+	entity->path.clear();
+	entity->flowField.reset();
+	entity->chaseTarget.reset();
+	entity->replanner.reset();
+	entity->leader.reset();
+	entity->trail.reset();
+}
+
+//***************
+// AssignGoalSlots
+// group order utility
+// spreads members over their own free cells nearest seedCell by path cost, one per member with an order,
+// then assigns them greedily, shortest member-to-slot distance first
+// slots are spaced so neighboring units of unitRadius don't overlap, and skip cells where units outside the group stand
+// goals holds each member's snapped goal (nullptr for none) and is overwritten with the assigned slots
+// arrivals, if set, holds where each member will approach the slots from instead of its current center
+// DEBUG: a member that can't reach any slot left over keeps its snapped goal
+//***************
+void AssignGoalSlots(const std::vector<std::shared_ptr<GameObject_t>> & group, std::vector<GridCell_t *> & goals, GridCell_t * seedCell, const int unitRadius, 
+					 const std::vector<SDL_Point> * arrivals = nullptr) {
+	static OpenSet_t openSet;
+	static std::vector<int> costs;
+	static std::vector<GridCell_t *> slots;
+	static std::vector<std::pair<int, std::pair<int, int>>> pairs;		// distance, { member, slot }
+	static std::vector<bool> memberDone;
+	static std::vector<bool> slotDone;
+
+	int count = 0;
+	for (auto && goal : goals)
+		count += (goal != nullptr) ? 1 : 0;
+
+	// nearest slots by reverse Dijkstra from seedCell, stopped once there are enough
+	int spacing = unitRadius <= 0 ? 2 : 2 * unitRadius + 1;
+	auto OnLattice = [seedCell, spacing, unitRadius](const GridCell_t * cell) {
+		int rows = cell->gridRow - seedCell->gridRow;
+		int cols = cell->gridCol - seedCell->gridCol;
+		if (unitRadius <= 0)
+			return ((rows + cols) % 2 + 2) % 2 == 0;		// checkerboard, diagonal neighbors don't overlap
+		return (rows % spacing + spacing) % spacing == 0 && (cols % spacing + spacing) % spacing == 0;
+	};
+	auto Occupied = [&group](const GridCell_t * cell) {
+		for (auto && other : cell->contents) {
+			if (other->type != OBJECTTYPE_MISSILE && std::find(group.begin(), group.end(), other) == group.end())
+				return true;
+		}
+		return false;
+	};
+
+	slots.clear();
+	costs.assign(gridCellCount, -1);
+	openSet.Clear();
+	openSet.mode = OPENSET_BINARY_HEAP;
+	costs[CellIndex(seedCell)] = 0;
+	openSet.Push(CellIndex(seedCell), 0, 0);
+	while (!openSet.Empty() && (int)slots.size() < count) {
+		int currentIndex = openSet.Pop();
+		GridCell_t * cell = IndexToCell(currentIndex);
+		if (OnLattice(cell) && clearance.distances[currentIndex] > unitRadius && !Occupied(cell))
+			slots.push_back(cell);
+
+		for (int edge = navGraph.offsets[currentIndex]; edge < navGraph.offsets[currentIndex + 1]; edge++) {
+			const NavEdge_t & step = navGraph.edges[edge];
+			if (unitRadius >= 0 && !UnitFits(step.cell, NavEdge_t{ (Uint16)currentIndex, step.cost, (Uint8)(7 - step.direction) }, unitRadius))
+				continue;
+
+			int cost = costs[currentIndex] + step.cost;
+			if (costs[step.cell] == -1 || cost < costs[step.cell]) {
+				costs[step.cell] = cost;
+				openSet.Push(step.cell, cost, 0);
+			}
+		}
+	}
+	openSet.Clear();
+
+	// greedy matching
+	pairs.clear();
+	for (int member = 0; member < (int)group.size(); member++) {
+		if (goals[member] == nullptr)
+			continue;
+
+		GridCell_t * startCell = &PointToCell(SDL_Point{ (int)group[member]->center.x, (int)group[member]->center.y });
+		GridCell_t * arrivalCell = arrivals ? &PointToCell((*arrivals)[member]) : startCell;
+		for (int slot = 0; slot < (int)slots.size(); slot++) {
+			if (CellsConnected(startCell, slots[slot]) || startCell->solid)
+				pairs.push_back({ GetDistance(arrivalCell, slots[slot]), { member, slot } });
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+
+	memberDone.assign(group.size(), false);
+	slotDone.assign(slots.size(), false);
+	for (auto && pair : pairs) {
+		int member = pair.second.first;
+		int slot = pair.second.second;
+		if (memberDone[member] || slotDone[slot])
+			continue;
+		memberDone[member] = true;
+		slotDone[slot] = true;
+		goals[member] = slots[slot];
+	}
+}
+
+//***************
+// OrderFormation
+// group order utility
+// pathfinds only the member nearest its goal, as the leader, to that goal, or the next nearest if it gets no path
+// and gives every other member with a goal a spot in a lattice behind and beside the leader to steer to, see FollowLeader
+// spots go to members greedily, nearest their current offset from the leader first
+// with goalSlots members end at the slots nearest their spots once the leader arrives, see AssignGoalSlots
+// goals holds each member's snapped goal, nullptr for none
+// DEBUG: followers keep the groupID neighbors they separate from, see SelectGroup
+//***************
+void OrderFormation(std::vector<std::shared_ptr<GameObject_t>> & group, std::vector<GridCell_t *> & goals, const int unitRadius) {
+	static std::vector<Vec2_t> offsets;
+	static std::vector<SDL_Point> arrivals;
+	static std::vector<std::pair<int, int>> candidates;					// distance to goal, member
+	static std::vector<std::pair<float, std::pair<int, int>>> pairs;		// squared distance, { member, offset }
+	static std::vector<bool> memberDone;
+	static std::vector<bool> offsetDone;
+
+	int count = 0;
+	candidates.clear();
+	for (int member = 0; member < (int)group.size(); member++) {
+		if (goals[member] == nullptr)
+			continue;
+
+		group[member]->goal = &goals[member]->center;
+		int range = GetDistance(&PointToCell(SDL_Point{ (int)group[member]->center.x, (int)group[member]->center.y }), goals[member]);
+		if (range > 0)
+			candidates.push_back({ range, member });
+		count++;
+	}
+
+	// the first candidate that gets a path leads, if none does every member that tried keeps its own PathFind result
+	// DEBUG: a member already on its goal cell has no path to lead along
+	std::sort(candidates.begin(), candidates.end());
+	int leaderIndex = -1;
+	for (auto && candidate : candidates) {
+		std::shared_ptr<GameObject_t> & member = group[candidate.second];
+		if (PathFind(member, SDL_Point{ (int)member->center.x, (int)member->center.y }, *member->goal)) {
+			leaderIndex = candidate.second;
+			break;
+		}
+	}
+	if (leaderIndex == -1 || count == 1)
+		return;
+
+	std::shared_ptr<GameObject_t> & leader = group[leaderIndex];
+
+	// the nearest lattice spots to the leader as { forward, sideways }, leaving its own
+	int reach = 1;
+	while ((reach + 1) * (2 * reach + 1) < count)
+		reach++;
+	offsets.clear();
+	for (int forward = -reach; forward <= 0; forward++) {
+		for (int sideways = -reach; sideways <= reach; sideways++) {
+			if (forward != 0 || sideways != 0)
+				offsets.push_back(Vec2_t{ (float)(forward * formationSpacing), (float)(sideways * formationSpacing) });
+		}
+	}
+	std::sort(offsets.begin(), offsets.end(), [](auto && a, auto && b) { return a * a < b * b; });
+	offsets.resize(count - 1);
+
+	// greedy matching
+	Vec2_t heading = FormationHeading(*leader);
+	Vec2_t side = { -heading.y, heading.x };
+	pairs.clear();
+	for (int member = 0; member < (int)group.size(); member++) {
+		if (goals[member] == nullptr || member == leaderIndex)
+			continue;
+
+		Vec2_t relative = group[member]->center - leader->center;
+		Vec2_t currentOffset = { relative * heading, relative * side };
+		for (int offset = 0; offset < (int)offsets.size(); offset++) {
+			Vec2_t range = offsets[offset] - currentOffset;
+			pairs.push_back({ range * range, { member, offset } });
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+
+	memberDone.assign(group.size(), false);
+	offsetDone.assign(offsets.size(), false);
+	for (auto && pair : pairs) {
+		int member = pair.second.first;
+		int offset = pair.second.second;
+		if (memberDone[member] || offsetDone[offset])
+			continue;
+		memberDone[member] = true;
+		offsetDone[offset] = true;
+		group[member]->formationOffset = offsets[offset];
+	}
+
+	// goal slots by where each spot will be once the leader arrives, facing the way it came
+	if (goalSlots) {
+		GridCell_t * leaderGoal = goals[leaderIndex];
+		SDL_Point from = (leader->path.size() >= 2) ? leader->path[1]->center : SDL_Point{ (int)leader->center.x, (int)leader->center.y };
+		Vec2_t approach = { (float)(leaderGoal->center.x - from.x), (float)(leaderGoal->center.y - from.y) };
+		Normalize(approach);
+		if (approach == vec2zero)
+			approach = heading;
+		Vec2_t approachSide = { -approach.y, approach.x };
+
+		arrivals.assign(group.size(), leaderGoal->center);
+		for (int member = 0; member < (int)group.size(); member++) {
+			if (memberDone[member]) {
+				Vec2_t offset = approach * group[member]->formationOffset.x + approachSide * group[member]->formationOffset.y;
+				arrivals[member].x += (int)offset.x;
+				arrivals[member].y += (int)offset.y;
+			}
+		}
+		AssignGoalSlots(group, goals, leaderGoal, unitRadius, &arrivals);
+
+		for (int member = 0; member < (int)group.size(); member++) {
+			if (goals[member] != nullptr)
+				group[member]->goal = &goals[member]->center;
+		}
+		if (goals[leaderIndex] != leaderGoal)
+			PathFind(leader, SDL_Point{ (int)leader->center.x, (int)leader->center.y }, *leader->goal);
+	}
+
+	std::shared_ptr<Path_t> trail = std::make_shared<Path_t>(leader->path);
+	trail->push_back(&PointToCell(SDL_Point{ (int)leader->center.x, (int)leader->center.y }));
+	for (int member = 0; member < (int)group.size(); member++) {
+		if (memberDone[member]) {
+			group[member]->leader = leader;
+			group[member]->trail = trail;
+		}
+	}
+}
+
+//***************
+// OrderGroupMove
+// pathfinds every group member to the goal using the current groupMoveMode
+// a solid or walled off goal snaps to the nearest cell each member can reach, see NearestReachableCell
+// in GROUPMOVE_FORMATION only a leader pathfinds and the rest follow it, see OrderFormation,
+// otherwise with goalSlots each member is sent to its own cell around it, see AssignGoalSlots
+// DEBUG: members sharing a snapped goal and unit size share its flow field, 
+// and leave it for their slot once as close to the goal, see FollowFlowField
+// WHCA* members each need a flow field to their own slot
+//***************
+void OrderGroupMove(std::vector<std::shared_ptr<GameObject_t>> & group, const SDL_Point & goal) {
+	static std::vector<PathRequest_t> requests;
+	static std::vector<std::shared_ptr<FlowField_t>> flowFields;
+	static std::vector<GridCell_t *> snappedGoals;
+	static std::vector<GridCell_t *> slotGoals;
+	GridCell_t & cell = PointToCell(goal);
+	// DEBUG: WHCA* reservations already spread the group, and its heuristic needs the plain flow field costs
+	int congestion = (congestionCosts && groupMoveMode != GROUPMOVE_COOPERATIVE) ? congestionCost : 0;
+
+	snappedGoals.clear();
+	int slotRadius = -1;
+	for (auto && entity : group) {
+		CancelOrder(entity);
+		entity->goal = &cell.center;
+		GridCell_t * startCell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+		int unitRadius = sizeAwarePaths ? UnitRadius(*entity) : -1;
+		snappedGoals.push_back(NearestReachableCell(startCell, &cell, unitRadius));
+		slotRadius = unitRadius > slotRadius ? unitRadius : slotRadius;
+	}
+
+	if (groupMoveMode == GROUPMOVE_FORMATION) {
+		OrderFormation(group, snappedGoals, slotRadius);
+		return;
+	}
+
+	slotGoals = snappedGoals;
+	auto seedCell = std::find_if(snappedGoals.begin(), snappedGoals.end(), [](auto && goalCell) { return goalCell != nullptr; });
+	if (goalSlots && seedCell != snappedGoals.end())
+		AssignGoalSlots(group, slotGoals, *seedCell, slotRadius);
+
+	for (int member = 0; member < (int)group.size(); member++) {
+		std::shared_ptr<GameObject_t> & entity = group[member];
+		GridCell_t * startCell = &PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y });
+		int unitRadius = sizeAwarePaths ? UnitRadius(*entity) : -1;
+		GridCell_t * goalCell = (groupMoveMode == GROUPMOVE_FLOW_FIELD) ? snappedGoals[member] : slotGoals[member];
+		if (goalCell == nullptr)
+			continue;
+		entity->goal = &slotGoals[member]->center;
+
+		if (groupMoveMode == GROUPMOVE_PATHFIND) {
+			requests.push_back(PathRequest_t{ entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, goalCell->center, false, congestion });
+			continue;
+		}
+
+		auto flowField = std::find_if(flowFields.begin(), flowFields.end(), [goalCell, unitRadius](auto && field) { 
+			return field->goalCell == goalCell && field->unitRadius == unitRadius; 
+		});
+		if (flowField == flowFields.end()) {
+			flowFields.push_back(std::make_shared<FlowField_t>());
+			flowField = flowFields.end() - 1;
+			BuildFlowField(**flowField, goalCell, unitRadius, congestion);
+		}
+		entity->flowField = *flowField;
+
+		// members plan in selection order, each around those before it
+		if (groupMoveMode == GROUPMOVE_COOPERATIVE)
+			ReserveCooperativePath(entity, startCell);
+	}
+
+	flowFields.clear();
+	if (!requests.empty()) {
+		PathFindBatch(requests);
+		requests.clear();
+	}
+}
+
+//***************
+// SelectGroup
+// monster selection
+//***************
+void SelectGroup(SDL_Point & first, SDL_Point & second) {
+
+	static std::vector<int> idList;
+
+	int firstRow;
+	int firstCol;
+	int secondRow;
+	int secondCol;
+	PointToCell(first, firstRow, firstCol);
+	PointToCell(second, secondRow, secondCol);
+
+	// get top-left and bottom-right indexes
+	int startRow	= (firstRow < secondRow) ? firstRow : secondRow;
+	int endRow		= (startRow == firstRow) ? secondRow : firstRow;
+	int startCol	= (firstCol < secondCol) ? firstCol : secondCol;
+	int endCol		= (startCol == firstCol) ? secondCol : firstCol;
+
+	// add all monsters in the selected area to a group
+	for (int row = startRow; row <= endRow; row++) {
+		for (int col = startCol; col <= endCol; col++) {
+			auto & target = gameGrid.cells[row][col];
+			if (!target.solid) {
+
+				for (auto && entity : target.contents) {
+					if (entity->health <= 0)
+						continue;
+					if (entity->type != OBJECTTYPE_MELEE && entity->type != OBJECTTYPE_RANGED)
+						continue;
+
+					// DEBUG: don't add the same entity twice for those over multiple cells
+					auto checkID = std::find(idList.begin(), idList.end(), entity->guid);
+					if (checkID == idList.end()) {
+						entity->selected = true;
+						entity->groupID = 4;		// TODO: random group number for now, but use available/forced group number tracking
+						groupSelection.push_back(entity);
+						idList.push_back(entity->guid);
 					}
-					if (pathChanged || entity->path.empty())	// DEBUG: changing the path invalidates this loop's iterators
-						break;
 				}
-			} while (pathChanged && !entity->path.empty());
-*/
-// END FREEHILL path cell traversal and update test
+			}
+		}
+	}
+	idList.clear();
+}
+
+//***************
+// ClearGroupSelection
+//***************
+void ClearGroupSelection() {
+	for (auto && entity : groupSelection) {
+		entity->groupID = -1;
+		entity->selected = false;
+	}
+	groupSelection.clear();
+}
+
+//-------------------------------------END PER-FRAME FUNCTIONS-----------------------------------------//
+//-------------------------------------BEGIN BENCHMARK FUNCTIONS---------------------------------------//
+
+// pathfinding timings, written by RunBenchmarks
+std::ofstream benchmarkLog;
+
+//***************
+// GetElapsedMS
+// benchmark utility
+//***************
+double GetElapsedMS(const Uint64 startCounter) {
+	return (double)(SDL_GetPerformanceCounter() - startCounter) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+//***************
+// GetBenchmarkQueries
+// benchmark utility
+// fills queries with a repeatable set of random non-solid start and goal cells
+//***************
+void GetBenchmarkQueries(std::vector<std::pair<GridCell_t *, GridCell_t *>> & queries, const int count, const unsigned int seed, const int minDistance = 0) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> randomCell(0, gridCellCount - 1);
+
+	queries.clear();
+	while ((int)queries.size() < count) {
+		GridCell_t * start = IndexToCell(randomCell(generator));
+		GridCell_t * goal = IndexToCell(randomCell(generator));
+		if (start->solid || goal->solid || start == goal || GetDistance(start, goal) < minDistance)
+			continue;
+		queries.push_back(std::make_pair(start, goal));
+	}
+}
+
+//***************
+// GetBenchmarkSpots
+// benchmark utility
+// returns the pair of cells in the largest component farthest apart of a few repeatable candidates
+// or { nullptr, nullptr } if none are in the largest component
+//***************
+std::pair<GridCell_t *, GridCell_t *> GetBenchmarkSpots(const unsigned int seed) {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::pair<GridCell_t *, GridCell_t *> spots = { nullptr, nullptr };
+
+	GetBenchmarkQueries(queries, 50, seed, 300);
+	for (auto && query : queries) {
+		if (query.first->component == components.largest && query.second->component == components.largest &&
+			(spots.first == nullptr || GetDistance(query.first, query.second) > GetDistance(spots.first, spots.second)))
+			spots = query;
+	}
+	return spots;
+}
+
+//***************
+// GetPathCost
+// benchmark utility
+// sums the step costs along a path to verify modes agree
+//***************
+int GetPathCost(const Path_t & path) {
+	int cost = 0;
+	for (size_t index = 1; index < path.size(); index++)
+		cost += GetDistance(path[index - 1], path[index]);
+	return cost;
+}
+
+//***************
+// TimeQueries
+// benchmark utility
+// runs PathFind over all queries with the current modes and logs the totals
+// returns the mean expansions per query
+//***************
+double TimeQueries(const char * label, const std::vector<std::pair<GridCell_t *, GridCell_t *>> & queries) {
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	int found = 0;
+	int totalCost = 0;
+	double expansions = 0.0;
+
+	Uint64 startCounter = SDL_GetPerformanceCounter();
+	for (auto && query : queries) {
+		mainSearchContext.expansions = 0;
+		if (PathFind(entity, query.first->center, query.second->center)) {
+			found++;
+			totalCost += GetPathCost(entity->path);
+		}
+		expansions += mainSearchContext.expansions;
+	}
+	double elapsed = GetElapsedMS(startCounter);
+
+	benchmarkLog << "\t" << label << ": " << elapsed << " ms total, " 
+				<< elapsed * 1000.0 / queries.size() << " us/query, " 
+				<< expansions / queries.size() << " expansions/query, "
+				<< found << " paths, total cost " << totalCost << '\n';
+	return expansions / queries.size();
+}
+
+//***************
+// GenerateBenchmarkMap
+// benchmark utility
+// replaces the gameGrid collision with a generated layout
+// rooms != 0 walls off rooms of that many cells with two-cell doorways
+// then scatters solid cells over about density of the map
+//***************
+void GenerateBenchmarkMap(const int rooms, const float density, const unsigned int seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+	for (auto && arry : gameGrid.cells)
+		for (auto && cell : arry)
+			cell.solid = chance(generator) < density;
+
+	if (rooms) {
+		std::uniform_int_distribution<int> door(1, rooms - 2);
+		for (int row = 0; row < gridRows; row++) {
+			for (int col = 0; col < gridCols; col++) {
+				if (row % rooms == 0 || col % rooms == 0)
+					gameGrid.cells[row][col].solid = true;
+			}
+		}
+
+		// knock a doorway into the bottom and right walls of every room
+		for (int row = 0; row < gridRows; row += rooms) {
+			for (int col = 0; col < gridCols; col += rooms) {
+				int offset = door(generator);
+				for (int gap = 0; gap < 2; gap++) {
+					if (row + rooms < gridRows && col + offset + gap < gridCols)
+						gameGrid.cells[row + rooms][col + offset + gap].solid = false;
+					if (col + rooms < gridCols && row + offset + gap < gridRows)
+						gameGrid.cells[row + offset + gap][col + rooms].solid = false;
+				}
+			}
+		}
+	}
+	BakeNavigation();
+}
+
+//***************
+// SaveCollision
+// benchmark utility
+//***************
+void SaveCollision(std::vector<bool> & collision) {
+	collision.clear();
+	for (int index = 0; index < gridCellCount; index++)
+		collision.push_back(IndexToCell(index)->solid);
+}
+
+//***************
+// RestoreCollision
+// benchmark utility
+//***************
+void RestoreCollision(const std::vector<bool> & collision) {
+	for (int index = 0; index < gridCellCount; index++)
+		IndexToCell(index)->solid = collision[index];
+	BakeNavigation();
+}
+
+//***************
+// ForEachBenchmarkMap
+// benchmark utility
+// calls back on graphics/collision.txt then on each generated map seeded with seed,
+// restoring the gameGrid collision afterwards
+//***************
+void ForEachBenchmarkMap(const unsigned int seed, const std::function<void(const char * mapName)> & callback) {
+	static const struct { const char * name; int rooms; float density; } maps[] = {
+		{ "graphics/collision.txt", 0, 0.0f },
+		{ "open field, 10% scattered", 0, 0.1f },
+		{ "open field, 30% scattered", 0, 0.3f },
+		{ "8x8 rooms, 5% scattered", 8, 0.05f },
+		{ "5x5 rooms, 10% scattered", 5, 0.1f }
+	};
+	std::vector<bool> collision;
+
+	SaveCollision(collision);
+	for (auto && map : maps) {
+		if (map.rooms || map.density > 0.0f)
+			GenerateBenchmarkMap(map.rooms, map.density, seed);
+		callback(map.name);
+	}
+	RestoreCollision(collision);
+}
+
+//***************
+// BenchmarkOpenSets
+// times identical PathFind queries with each OpenSetMode_t
+//***************
+void BenchmarkOpenSets() {
+	static const char * modeNames[] = { "make_heap (original)", "binary heap", "bucket queue" };
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	OpenSetMode_t oldMode = openSetMode;
+
+	GetBenchmarkQueries(queries, 1000, 1);
+	benchmarkLog << "PathFind open set, " << queries.size() << " random queries on graphics/collision.txt\n";
+	for (int mode = OPENSET_MAKE_HEAP; mode <= OPENSET_BUCKET_QUEUE; mode++) {
+		openSetMode = (OpenSetMode_t)mode;
+		TimeQueries(modeNames[mode], queries);
+	}
+	benchmarkLog << '\n';
+	openSetMode = oldMode;
+}
+
+//***************
+// BenchmarkJumpPointSearch
+// times A* against jump point search and JPS+ on the game map and generated maps
+// DEBUG: gameGrid dimensions are compile-time, so generated maps are the same size as the game map
+//***************
+void BenchmarkJumpPointSearch() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+
+	benchmarkLog << "A* vs jump point search vs JPS+, 1000 random queries per map\n";
+	ForEachBenchmarkMap(4, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 5);
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		BakeJumpTable(BakedUnitRadius());
+		double bakeElapsed = GetElapsedMS(startCounter);
+
+		benchmarkLog << mapName << ", JPS+ jump table " << jumpTable.distances.size() * sizeof(jumpTable.distances[0]) 
+					<< " bytes baked in " << bakeElapsed << " ms\n";
+		pathFindMode = PATHFIND_ASTAR;
+		TimeQueries("A*", queries);
+		pathFindMode = PATHFIND_JPS;
+		TimeQueries("JPS", queries);
+		pathFindMode = PATHFIND_JPS_PLUS;
+		TimeQueries("JPS+", queries);
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+}
+
+//***************
+// BenchmarkHierarchy
+// A* vs HPA* path costs and search times,
+// and the cost of rebuilding one cluster vs the whole abstract graph
+//***************
+void BenchmarkHierarchy() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+
+	benchmarkLog << "A* vs HPA* (" << clusterSize << "x" << clusterSize << " clusters), 1000 random queries per map\n";
+	ForEachBenchmarkMap(6, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 7);
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		BuildHierarchy(BakedUnitRadius());
+		double buildElapsed = GetElapsedMS(startCounter);
+
+		startCounter = SDL_GetPerformanceCounter();
+		for (int cluster = 0; cluster < clusterCount; cluster++)
+			RebuildCluster(cluster);
+		double rebuildElapsed = GetElapsedMS(startCounter) / clusterCount;
+
+		size_t entranceCount = 0;
+		for (auto && entrances : hierarchy.entrances)
+			entranceCount += entrances.size();
+
+		benchmarkLog << mapName << ", " << entranceCount << " entrances, full build " << buildElapsed 
+					<< " ms, one cluster rebuild " << rebuildElapsed << " ms\n";
+		pathFindMode = PATHFIND_ASTAR;
+		TimeQueries("A*", queries);
+		pathFindMode = PATHFIND_HPA;
+		TimeQueries("HPA*", queries);
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+}
+
+//***************
+// BenchmarkPathCache
+// units ordered back and forth between a few spots, at several pathCache capacities
+//***************
+void BenchmarkPathCache() {
+	static const size_t capacities[] = { 0, 8, 32, 256 };
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> spots;
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::mt19937 generator(8);
+
+	GetBenchmarkQueries(spots, 8, 9);
+	std::uniform_int_distribution<int> spot(0, spots.size() * 2 - 1);
+	while (queries.size() < 1000) {
+		int first = spot(generator);
+		int second = spot(generator);
+		GridCell_t * startCell = (first & 1) ? spots[first / 2].second : spots[first / 2].first;
+		GridCell_t * endCell = (second & 1) ? spots[second / 2].second : spots[second / 2].first;
+		if (startCell != endCell)
+			queries.push_back(std::make_pair(startCell, endCell));
+	}
+
+	benchmarkLog << "PathFind cache, " << queries.size() << " queries between " << spots.size() * 2 << " spots on graphics/collision.txt\n";
+	for (auto && capacity : capacities) {
+		ClearPathCache();
+		pathCache.capacity = capacity;
+		pathCache.hits = 0;
+		pathCache.misses = 0;
+
+		std::string label = "capacity " + std::to_string(capacity);
+		TimeQueries(label.c_str(), queries);
+		benchmarkLog << "\t\t" << pathCache.hits << " hits, " << pathCache.misses << " misses\n";
+	}
+	benchmarkLog << '\n';
+	ClearPathCache();
+}
+
+//***************
+// BenchmarkBidirectional
+// A* vs bidirectional A* on long cross-map queries
+//***************
+void BenchmarkBidirectional() {
+	static const int minDistance = 400;		// 40 straight steps, most of the map width
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+
+	benchmarkLog << "A* vs bidirectional A*, 1000 random queries per map at least " << minDistance << " apart\n";
+	ForEachBenchmarkMap(17, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 18, minDistance);
+
+		benchmarkLog << mapName << '\n';
+		pathFindMode = PATHFIND_ASTAR;
+		TimeQueries("A*", queries);
+		pathFindMode = PATHFIND_BIDIRECTIONAL;
+		TimeQueries("bidirectional A*", queries);
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+}
+
+//***************
+// BenchmarkLandmarks
+// A* expansions with the octile heuristic vs the ALT landmarks heuristic
+//***************
+void BenchmarkLandmarks() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldPathFindMode = pathFindMode;
+	HeuristicMode_t oldHeuristicMode = heuristicMode;
+
+	pathFindMode = PATHFIND_ASTAR;
+	benchmarkLog << "A* octile vs ALT heuristic (" << landmarkCount << " landmarks), 1000 random queries per map\n";
+	ForEachBenchmarkMap(13, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 14);
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		BuildLandmarks();
+		double buildElapsed = GetElapsedMS(startCounter);
+
+		benchmarkLog << mapName << ", landmarks built in " << buildElapsed << " ms\n";
+		heuristicMode = HEURISTIC_OCTILE;
+		double octileExpansions = TimeQueries("octile", queries);
+		heuristicMode = HEURISTIC_LANDMARKS;
+		double landmarkExpansions = TimeQueries("ALT", queries);
+		benchmarkLog << "\t" << octileExpansions - landmarkExpansions << " expansions/query saved (" 
+					<< 100.0 * (octileExpansions - landmarkExpansions) / octileExpansions << "%)\n";
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldPathFindMode;
+	heuristicMode = oldHeuristicMode;
+}
+
+//***************
+// BenchmarkSizeAware
+// point-sized vs size-aware PathFind for monster-sized and larger units
+// counting the grid steps whose unit bounds would clip a solid cell
+//***************
+void BenchmarkSizeAware() {
+	static const int unitSizes[] = { 16, 48 };		// a monster's 14x16 bounds, and a 3x3 cell unit
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	PathFindMode_t oldMode = pathFindMode;
+	bool oldSizeAware = sizeAwarePaths;
+
+	pathFindMode = PATHFIND_ASTAR;
+	benchmarkLog << "Point-sized vs size-aware A*, 1000 random queries per map\n";
+	ForEachBenchmarkMap(21, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 22);
+		benchmarkLog << mapName << '\n';
+
+		for (auto && unitSize : unitSizes) {
+			entity->bounds.w = unitSize;
+			entity->bounds.h = unitSize;
+			int unitRadius = UnitRadius(*entity);
+
+			for (int pass = 0; pass < 2; pass++) {
+				sizeAwarePaths = (pass == 1);
+				int found = 0;
+				int clipping = 0;
+				Uint64 startCounter = SDL_GetPerformanceCounter();
+				for (auto && query : queries) {
+					if (!PathFind(entity, query.first->center, query.second->center))
+						continue;
+					found++;
+
+					// DEBUG: untimed would be fairer, but this is cheap next to the search
+					for (size_t index = 1; index < entity->path.size(); index++) {
+						int cellIndex = CellIndex(entity->path[index]);
+						int nextIndex = CellIndex(entity->path[index - 1]);
+						for (int edge = navGraph.offsets[cellIndex]; edge < navGraph.offsets[cellIndex + 1]; edge++) {
+							if (navGraph.edges[edge].cell == nextIndex && !UnitFits(cellIndex, navGraph.edges[edge], unitRadius)) {
+								clipping++;
+								break;
+							}
+						}
+					}
+				}
+				double elapsed = GetElapsedMS(startCounter);
+
+				benchmarkLog << "\t" << unitSize << "px unit, " << (sizeAwarePaths ? "size-aware: " : "point-sized: ") << elapsed << " ms total, " 
+							<< found << " paths, " << clipping << " steps clipping collision\n";
+			}
+		}
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+	sizeAwarePaths = oldSizeAware;
+}
+
+//***************
+// BenchmarkNavGraph
+// navGraph bake cost and size, and A* paths with and without corner cutting
+//***************
+void BenchmarkNavGraph() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+	bool oldCornerCutting = cornerCutting;
+
+	pathFindMode = PATHFIND_ASTAR;
+	benchmarkLog << "A* over the baked navGraph, corner cutting vs none, 1000 random queries per map\n";
+	ForEachBenchmarkMap(15, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 16);
+
+		for (int pass = 0; pass < 2; pass++) {
+			cornerCutting = (pass == 0);
+			BakeNavigation();
+
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+			BakeNavGraph();
+			double bakeElapsed = GetElapsedMS(startCounter);
+
+			size_t bytes = navGraph.offsets.size() * sizeof(navGraph.offsets[0]) + 
+							navGraph.edges.size() * sizeof(navGraph.edges[0]) + 
+							navGraph.walkable.size() * sizeof(navGraph.walkable[0]);
+			benchmarkLog << mapName << (cornerCutting ? ", corner cutting, " : ", no corner cutting, ") << navGraph.edges.size() 
+						<< " edges, " << bytes << " bytes baked in " << bakeElapsed << " ms\n";
+			TimeQueries("A*", queries);
+		}
+		cornerCutting = oldCornerCutting;	// DEBUG: before the next map or the restored collision is baked
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+}
 
-		// determine optimal unit-velocity and speed 
-		Vec2_t move = vec2zero;
+//***************
+// BenchmarkAnyAngle
+// waypoints and walked distance of grid paths vs SmoothPath any-angle paths
+//***************
+void BenchmarkAnyAngle() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	Path_t smoothed;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	bool oldAnyAngle = anyAnglePaths;
+
+	anyAnglePaths = false;
+	benchmarkLog << "Grid paths vs any-angle paths, 1000 random queries per map\n";
+	ForEachBenchmarkMap(15, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 16);
+
+		int found = 0;
+		double gridWaypoints = 0.0;
+		double smoothWaypoints = 0.0;
+		double gridLength = 0.0;
+		double smoothLength = 0.0;
+		double elapsed = 0.0;
+		for (auto && query : queries) {
+			if (!PathFind(entity, query.first->center, query.second->center))
+				continue;
+
+			smoothed = entity->path;
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+			SmoothPath(smoothed);
+			elapsed += GetElapsedMS(startCounter);
+
+			found++;
+			gridWaypoints += entity->path.size();
+			smoothWaypoints += smoothed.size();
+			for (int pass = 0; pass < 2; pass++) {
+				auto & path = pass == 0 ? entity->path : smoothed;
+				double & length = pass == 0 ? gridLength : smoothLength;
+				for (size_t index = 1; index < path.size(); index++) {
+					Vec2_t step = {	(float)(path[index]->center.x - path[index - 1]->center.x), 
+									(float)(path[index]->center.y - path[index - 1]->center.y) };
+					length += SDL_sqrtf(step.x * step.x + step.y * step.y);
+				}
+			}
+		}
 
-		if (!entity->path.empty()) {
+		benchmarkLog << mapName << ", " << found << " paths, SmoothPath " << elapsed * 1000.0 / found << " us/path\n"
+					<< "\tgrid: " << gridWaypoints / found << " waypoints/path, " << gridLength / found << " px/path\n"
+					<< "\tany-angle: " << smoothWaypoints / found << " waypoints/path, " << smoothLength / found << " px/path\n";
+	});
+	benchmarkLog << '\n';
 
-			// head towards last waypoint if off-path,
-			// otherwise use the local gradient
-			CheckPathCell(entity);
-			areaContents.Update(entity->center, entity);
+	anyAnglePaths = oldAnyAngle;
+}
 
-///////////////////////////////////////////////////////////////////////////
-// BEGIN FREEHILL yielding cooperation test
-	// DEBUG: path.empty() may be true here because of CheckCellPath(entity)
-	// 1) yield to a collision entity (ie the closest one during CheckForwardCollision)....maybe
-	// 2) ???
-	// 3) profit.
-// END FREEHILL yielding cooperation test
-///////////////////////////////////////////////////////////////////////////
+//***************
+// BenchmarkChase
+// a chaser walking towards a wandering target, with occasional SetCellSolid changes
+// times a PathFind every step against repairing one DStarLiteSearch tree
+//***************
+void BenchmarkChase() {
+	static const int stepCount = 100;
+	static const int changeInterval = 10;
+	static const int wanderIntervals[] = { 1, 4, 0 };		// steps between target moves, 0 for a stationary target
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	Path_t replannedPath;
+	std::vector<bool> collision;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+
+	SaveCollision(collision);
+	GetBenchmarkQueries(queries, 20, 12);
+	benchmarkLog << "Chasing a wandering target on graphics/collision.txt, PathFind every step vs D* Lite repair, a SetCellSolid every " 
+				<< changeInterval << " steps\n";
+	for (auto && wanderInterval : wanderIntervals) {
+		std::mt19937 generator(11);
+		std::uniform_int_distribution<int> direction(0, 7);
+		std::uniform_int_distribution<int> anyCell(0, gridCellCount - 1);
+		double pathFindElapsed = 0.0;
+		double replanElapsed = 0.0;
+		double pathFindExpansions = 0.0;
+		double replanExpansions = 0.0;
+		int searches = 0;
+		int mismatches = 0;
+
+		for (auto && query : queries) {
+			GridCell_t * chaser = query.first;
+			GridCell_t * target = query.second;
+			DStarLite_t planner;
+
+			for (int step = 0; step < stepCount && chaser != target; step++) {
+				if (wanderInterval && step % wanderInterval == 0) {
+					SDL_Point offset = neighborOffsets[direction(generator)];
+					if (IsWalkable(target->gridRow + offset.x, target->gridCol + offset.y))
+						target = &gameGrid.cells[target->gridRow + offset.x][target->gridCol + offset.y];
+				}
 
-			if (entity->onPath && entity->path.size() >= 2) {
-				auto & from = entity->path.at(entity->path.size() - 1)->center;
-				auto & to = entity->path.at(entity->path.size() - 2)->center;
-				Vec2_t localGradient = { (float)(to.x - from.x), (float)(to.y - from.y) };
-				Normalize(localGradient);
-				entity->velocity = localGradient;
-			} else if (!entity->path.empty()) {	// !entity->onPath || entity->path.size() < 2
-				// FIXME/BUG: check if the path is empty again here
-				// ...or change CheckPathCell to not pop_back a waypoint
-				auto & currentWaypoint = entity->path.back()->center;
-				if (!CheckWaypointRange(entity)) {
-					Vec2_t waypointVec = {	(float)(currentWaypoint.x - entity->center.x),
-											(float)(currentWaypoint.y - entity->center.y)	};
-					Normalize(waypointVec);
-					entity->velocity = waypointVec;
-				} else {
-					entity->path.pop_back();
-					entity->velocity = vec2zero;
+				// DEBUG: rebuilds the other navigation data too, so stays untimed
+				if (step % changeInterval == changeInterval - 1) {
+					GridCell_t * changed = IndexToCell(anyCell(generator));
+					if (changed != chaser && changed != target)
+						SetCellSolid(*changed, !changed->solid);
 				}
+				if (!CellsConnected(chaser, target))
+					break;
+
+				mainSearchContext.expansions = 0;
+				Uint64 startCounter = SDL_GetPerformanceCounter();
+				PathFind(entity, chaser->center, target->center);
+				pathFindElapsed += GetElapsedMS(startCounter);
+				pathFindExpansions += mainSearchContext.expansions;
+
+				startCounter = SDL_GetPerformanceCounter();
+				DStarLiteSearch(planner, chaser, target);
+				DStarLitePath(planner, replannedPath);
+				replanElapsed += GetElapsedMS(startCounter);
+				replanExpansions += planner.expansions;
+
+				searches++;
+				if (GetPathCost(replannedPath) != GetPathCost(entity->path))
+					mismatches++;
+
+				// the chaser takes one step
+				if (entity->path.size() >= 2)
+					chaser = entity->path[entity->path.size() - 2];
 			}
-									
-// BEGIN FREEHILL flocking test
-/*
-			// FIXME: dont use specific waypoints because entities wind up jostling for the same waypoint
-			// FIXME: these steering forces need to be better balanced so they dont cancel eachother out all the time
-			// FIXME: using this with gradient velocities throws entities off the end of the trail infinitely (until given a new path)
-			Vec2_t alignment, cohesion, separation;
-			GetGroupAlignment(areaEntities, entity, alignment);
-			GetGroupCohesion(areaEntities, entity, cohesion);
-			GetGroupSeparation(areaEntities, entity, separation);
-			entity->velocity +=  separation + alignment + cohesion;
-			Normalize(entity->velocity);
-*/
-// END FREEHILL flocking test
+			RestoreCollision(collision);
+		}
 
-			// stop moving if the path is crowded
-			std::shared_ptr<GameObject_t> collisionEntity;
-			float fraction = CheckForwardCollision(entity, areaContents, collisionEntity);
-			if (fraction < 1.0f && collisionEntity) {
-				if (collisionEntity->velocity == vec2zero) {
-					// FIXME: occasional perma-bob vibrator due to clear path but obstructed velocity
-					// (collision check doesn't quite fix this)
-					bool pathCrowded = std::find_if(	entity->path.begin(), 
-														entity->path.end(),
-														[&entity](auto && cell) { 
-															return EMPTY_EXCEPT_SELF((*cell), entity);	// cell->contents.empty();
-													}) == entity->path.end();
-					if (pathCrowded) { 
-						entity->velocity = vec2zero;
+		if (wanderInterval)
+			benchmarkLog << "\ttarget moving every " << wanderInterval << " steps, " << searches << " steps\n";
+		else
+			benchmarkLog << "\tstationary target, " << searches << " steps\n";
+		benchmarkLog
+					<< "\t\tPathFind: " << pathFindElapsed << " ms total, " << pathFindExpansions / searches << " expansions/step\n"
+					<< "\t\tD* Lite: " << replanElapsed << " ms total, " << replanExpansions / searches << " expansions/step, " 
+					<< mismatches << " path costs differing from PathFind\n";
+	}
+	benchmarkLog << '\n';
+}
+
+//***************
+// BenchmarkChaseTree
+// many chasers after one wandering target on graphics/collision.txt
+// PathFind per chaser vs one shared tree rebuilt or rerooted each time the target changes cells
+//***************
+void BenchmarkChaseTree() {
+	static const int chaserCounts[] = { 10, 100, 1000, 10000 };
+	static const int stepCount = 200;
+	static const int maxPathFindChasers = 100;		// DEBUG: more would take minutes
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::vector<GridCell_t *> chasers;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	std::shared_ptr<FlowField_t> rebuilt = std::make_shared<FlowField_t>();
+	std::shared_ptr<FlowField_t> rerooted = std::make_shared<FlowField_t>();
+
+	benchmarkLog << "Chasers after one target wandering every step on graphics/collision.txt, " << stepCount << " steps\n";
+	for (auto && chaserCount : chaserCounts) {
+		GetBenchmarkQueries(queries, chaserCount, 19);
+		GridCell_t * start = queries.front().second;
+		double elapsed[3] = { 0.0, 0.0, 0.0 };		// PathFind, rebuilt tree, rerooted tree
+		int relaxed = 0;
+		int targetMoves = 0;
+		int mismatches = 0;
+
+		for (int method = 0; method < 3; method++) {
+			if (method == 0 && chaserCount > maxPathFindChasers)
+				continue;
+
+			std::mt19937 generator(20);
+			std::uniform_int_distribution<int> direction(0, 7);
+			GridCell_t * target = start;
+			chasers.clear();
+			for (auto && query : queries) {
+				if (CellsConnected(query.first, target))
+					chasers.push_back(query.first);
+			}
+			BuildFlowField(*rerooted, target);
+
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+			for (int step = 0; step < stepCount; step++) {
+				SDL_Point offset = neighborOffsets[direction(generator)];
+				bool moved = IsWalkable(target->gridRow + offset.x, target->gridCol + offset.y);
+				if (moved)
+					target = &gameGrid.cells[target->gridRow + offset.x][target->gridCol + offset.y];
+
+				// each chaser takes one step
+				if (method == 1 && moved) {
+					BuildFlowField(*rebuilt, target);
+				} else if (method == 2 && moved) {
+					relaxed += RerootFlowField(*rerooted, target);
+					targetMoves++;
+				}
+
+				for (auto && chaser : chasers) {
+					if (chaser == target)
+						continue;
+
+					if (method == 0) {
+						PathFind(entity, chaser->center, target->center);
+						chaser = entity->path[entity->path.size() - 2];
+					} else {
+						chaser = (method == 1 ? rebuilt : rerooted)->Next(chaser);
 					}
 				}
 			}
+			elapsed[method] = GetElapsedMS(startCounter);
 
-			// pick a different trajectory if there's no way forward
-			// FIXME/BUG: because fraction reported is always > 0.0f the entity will always move
-			// which is probably why the entity walks straight into others (totally overlapping)
-			// FIXME: AvoidCollision() sets the velocity regardless of the fraction
-			// however fraction SHOULD stop it if its 0.0f (note: not the main issue)
-			if (entity->velocity != vec2zero)
-				fraction = AvoidCollision(entity, areaContents);
-			move = entity->velocity * entity->speed * fraction;// *((float)frameTime / 1000.0f);
-			UpdateOrigin(entity, move);
+			// DEBUG: untimed, every rerooted cost must match a fresh build
+			if (method == 2) {
+				BuildFlowField(*rebuilt, target);
+				for (int index = 0; index < gridCellCount; index++)
+					mismatches += rebuilt->costs[index] != rerooted->costs[index];
+			}
 		}
 
-		// if the entity moved, then update gameGrid and internal cell lists for collision filtering
-		if (move.x || move.y)
-			UpdateCellReferences(entity);
+		benchmarkLog << "\t" << chaserCount << " chasers: PathFind per chaser ";
+		if (chaserCount > maxPathFindChasers)
+			benchmarkLog << "skipped";
+		else
+			benchmarkLog << elapsed[0] << " ms";
+		benchmarkLog << ", rebuilt tree " << elapsed[1] << " ms, rerooted tree " << elapsed[2] << " ms (" 
+					<< (targetMoves ? relaxed / targetMoves : 0) << " cells relaxed/move, " << mismatches << " costs differing from a rebuild)\n";
+	}
+	benchmarkLog << '\n';
+}
 
-		UpdateBob(entity, move);		// DEBUG: bob does not affect cell location
+//***************
+// SpawnBenchmarkGroup
+// benchmark utility
+// spreads up to groupSize melee monsters over every other cell nearest spot
+// DEBUG: call ClearCellReferences on each member when done with them
+//***************
+void SpawnBenchmarkGroup(std::vector<std::shared_ptr<GameObject_t>> & group, GridCell_t * spot, const int groupSize, int guid) {
+	static FlowField_t distances;
+	std::vector<GridCell_t *> cells;
+
+	BuildFlowField(distances, spot);
+	for (int index = 0; index < gridCellCount; index++) {
+		GridCell_t * cell = IndexToCell(index);
+		if (distances.costs[index] >= 0 && cell->gridRow % 2 == 0 && cell->gridCol % 2 == 0 && cell->contents.empty())
+			cells.push_back(cell);
+	}
+	std::sort(cells.begin(), cells.end(), [](auto && a, auto && b) { 
+		return distances.costs[CellIndex(a)] < distances.costs[CellIndex(b)]; 
+	});
+
+	group.clear();
+	for (int member = 0; member < groupSize && member < (int)cells.size(); member++) {
+		SDL_Point origin = { cells[member]->center.x - 7, cells[member]->center.y - 12 };
+		group.push_back(std::make_shared<GameObject_t>(origin, std::string("benchmark"), guid++, OBJECTTYPE_MELEE));
+		UpdateCellReferences(group.back());
 	}
-	areaContents.Clear();
 }
 
 //***************
-// Fly
-// linear movement
+// BenchmarkCooperative
+// two groups ordered to swap places, stepping Walk directly on graphics/collision.txt
+// counts AvoidCollision sweeps, overlapping members, and members stuck with an order for each groupMoveMode,
+// without and with congestionCosts
 //***************
-void Fly(std::shared_ptr<GameObject_t> & entity) {
-	Uint32 dt = SDL_GetTicks() - entity->moveTime;
+void BenchmarkCooperative() {
+	static const char * modeNames[] = { "PathFind per member", "flow field", "cooperative (WHCA*)" };
+	static const int groupSize = 12;
+	static const int stepCount = 2400;
+	static const int stepsPerTick = reservationTickMS / 25;		// Walk moves every 25ms
+	std::vector<std::shared_ptr<GameObject_t>> groups[2];
+	std::vector<std::shared_ptr<GameObject_t>> members;
+	GroupMoveMode_t oldMode = groupMoveMode;
+	Uint32 oldNow = reservationTable.now;
+	bool oldCongestion = congestionCosts;
+
+	std::pair<GridCell_t *, GridCell_t *> spotPair = GetBenchmarkSpots(19);
+	GridCell_t * spots[2] = { spotPair.first, spotPair.second };
+	if (spots[0] == nullptr)
+		return;
 
-	if (dt >= 25) {
-		entity->moveTime = SDL_GetTicks();
-		Vec2_t move = entity->velocity * entity->speed;
-		UpdateOrigin(entity, move);
-		UpdateCellReferences(entity);
-		UpdateBob(entity, move);		// DEBUG: bob does not affect cell location
+	benchmarkLog << "Two groups of " << groupSize << " swapping places on graphics/collision.txt, " << stepCount << " Walk steps\n";
+	for (int run = 0; run < 2 * (GROUPMOVE_COOPERATIVE + 1); run++) {
+		int mode = run / 2;
+		groupMoveMode = (GroupMoveMode_t)mode;
+		congestionCosts = (run % 2 == 1);
+		reservationTable.now = 0;
+		avoidanceSweeps = 0;
+
+		SpawnBenchmarkGroup(groups[0], spots[0], groupSize, 100000);
+		SpawnBenchmarkGroup(groups[1], spots[1], groupSize, 100000 + groupSize);
+		OrderGroupMove(groups[0], spots[1]->center);
+		OrderGroupMove(groups[1], spots[0]->center);
+		members = groups[0];
+		members.insert(members.end(), groups[1].begin(), groups[1].end());
+
+		double overlaps = 0.0;
+		int stuck = 0;
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		for (int step = 0; step < stepCount; step++) {
+			reservationTable.now = step / stepsPerTick;
+			for (auto && group : groups) {
+				for (auto && entity : group) {
+					Vec2_t oldCenter = entity->center;
+					entity->moveTime = SDL_GetTicks() - 25;
+					Walk(entity);
+					if ((!entity->path.empty() || entity->flowField) && entity->center == oldCenter)
+						stuck++;
+				}
+			}
+
+			for (auto && a : members) {
+				for (auto && b : members) {
+					if (a->guid < b->guid && SDL_HasIntersection(&a->bounds, &b->bounds))
+						overlaps++;
+				}
+			}
+		}
+		double elapsed = GetElapsedMS(startCounter);
+
+		// DEBUG: a whole group can't fit on its goal cell, so also measure how closely it gathered
+		int finished = 0;
+		double distanceLeft = 0.0;
+		for (int group = 0; group < 2; group++) {
+			for (auto && entity : groups[group]) {
+				distanceLeft += GetDistance(&PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y }), spots[1 - group]);
+				if (entity->path.empty() && !entity->flowField)
+					finished++;
+				CancelOrder(entity);
+				ClearCellReferences(entity);
+			}
+		}
+
+		benchmarkLog << "\t" << modeNames[mode] << (congestionCosts ? ", congestion costs: " : ": ") << elapsed << " ms total, " 
+					<< (double)avoidanceSweeps / stepCount << " AvoidCollision sweeps/step, " 
+					<< overlaps / stepCount << " overlapping pairs/step, " 
+					<< (double)stuck / stepCount << " members stuck/step, " 
+					<< finished << " of " << members.size() << " orders finished, " 
+					<< distanceLeft / members.size() << " mean distance left to goal\n";
 	}
+	benchmarkLog << '\n';
+
+	groupMoveMode = oldMode;
+	reservationTable.now = oldNow;
+	congestionCosts = oldCongestion;
 }
 
 //***************
-// GoodmanThink
+// BenchmarkGoalSlots
+// one group ordered across graphics/collision.txt, stepping Walk directly
+// counts AvoidCollision sweeps and overlapping members once the group arrives for each groupMoveMode,
+// without and with goalSlots
 //***************
-void GoodmanThink(std::shared_ptr<GameObject_t> & entity) {
-	// TODO: Goodman's strategy/state here
-	Walk(entity);
+void BenchmarkGoalSlots() {
+	static const char * modeNames[] = { "PathFind per member", "flow field", "cooperative (WHCA*)" };
+	static const int groupSize = 16;
+	static const int stepCount = 2400;
+	static const int arrivalSteps = 600;							// final steps measured as the arrival
+	static const int stepsPerTick = reservationTickMS / 25;		// Walk moves every 25ms
+	std::vector<std::shared_ptr<GameObject_t>> group;
+	GroupMoveMode_t oldMode = groupMoveMode;
+	Uint32 oldNow = reservationTable.now;
+	bool oldGoalSlots = goalSlots;
+
+	std::pair<GridCell_t *, GridCell_t *> spots = GetBenchmarkSpots(23);
+	if (spots.first == nullptr)
+		return;
+
+	benchmarkLog << "One group of " << groupSize << " ordered to one cell on graphics/collision.txt, " << stepCount << " Walk steps, last " << arrivalSteps << " measured\n";
+	for (int run = 0; run < 2 * (GROUPMOVE_COOPERATIVE + 1); run++) {
+		int mode = run / 2;
+		groupMoveMode = (GroupMoveMode_t)mode;
+		goalSlots = (run % 2 == 1);
+		reservationTable.now = 0;
+
+		SpawnBenchmarkGroup(group, spots.first, groupSize, 200000);
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		OrderGroupMove(group, spots.second->center);
+		double orderElapsed = GetElapsedMS(startCounter);
+
+		double overlaps = 0.0;
+		int stuck = 0;
+		for (int step = 0; step < stepCount; step++) {
+			if (step == stepCount - arrivalSteps)
+				avoidanceSweeps = 0;
+
+			reservationTable.now = step / stepsPerTick;
+			for (auto && entity : group) {
+				Vec2_t oldCenter = entity->center;
+				entity->moveTime = SDL_GetTicks() - 25;
+				Walk(entity);
+				if (step >= stepCount - arrivalSteps && (!entity->path.empty() || entity->flowField) && entity->center == oldCenter)
+					stuck++;
+			}
+
+			if (step < stepCount - arrivalSteps)
+				continue;
+
+			for (auto && a : group) {
+				for (auto && b : group) {
+					if (a->guid < b->guid && SDL_HasIntersection(&a->bounds, &b->bounds))
+						overlaps++;
+				}
+			}
+		}
+
+		int finished = 0;
+		double distanceLeft = 0.0;
+		for (auto && entity : group) {
+			distanceLeft += GetDistance(&PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y }), spots.second);
+			if (entity->path.empty() && !entity->flowField)
+				finished++;
+			CancelOrder(entity);
+			ClearCellReferences(entity);
+		}
+
+		benchmarkLog << "\t" << modeNames[mode] << (goalSlots ? ", goal slots: " : ": ") << orderElapsed << " ms order, " 
+					<< (double)avoidanceSweeps / arrivalSteps << " AvoidCollision sweeps/step, " 
+					<< overlaps / arrivalSteps << " overlapping pairs/step, " 
+					<< (double)stuck / arrivalSteps << " members stuck/step, " 
+					<< finished << " of " << group.size() << " orders finished, " 
+					<< distanceLeft / group.size() << " mean distance left to goal\n";
+	}
+	benchmarkLog << '\n';
+
+	groupMoveMode = oldMode;
+	reservationTable.now = oldNow;
+	goalSlots = oldGoalSlots;
 }
 
 //***************
-// MeleeThink
-// TODO: master EntityThink() function calls this based on entity type
+// BenchmarkFormation
+// a few groups ordered across graphics/collision.txt, stepping Walk directly
+// times the order and each step of Walk for the whole group, PathFind per member vs GROUPMOVE_FORMATION,
+// and measures how tightly the group keeps together on the way
 //***************
-void MeleeThink(std::shared_ptr<GameObject_t> & entity) {
-	// TODO: resolve standing orders
-	Walk(entity);
+void BenchmarkFormation() {
+	static const GroupMoveMode_t modes[] = { GROUPMOVE_PATHFIND, GROUPMOVE_FORMATION };
+	static const char * modeNames[] = { "PathFind per member", "leader-follower formation" };
+	static const int groupSizes[] = { 16, 48 };
+	static const int querySeeds[] = { 29, 3, 5, 7, 11, 13 };
+	static const int orderCount = sizeof(querySeeds) / sizeof(querySeeds[0]);
+	static const int stepCount = 2400;
+	std::vector<std::shared_ptr<GameObject_t>> group;
+	GroupMoveMode_t oldMode = groupMoveMode;
+
+	std::pair<GridCell_t *, GridCell_t *> spots[orderCount];
+	for (int order = 0; order < orderCount; order++) {
+		spots[order] = GetBenchmarkSpots(querySeeds[order]);
+		if (spots[order].first == nullptr)
+			return;
+	}
+
+	benchmarkLog << orderCount << " groups ordered to one cell each on graphics/collision.txt, " << stepCount << " Walk steps per order\n";
+	for (auto && groupSize : groupSizes) {
+		for (int mode = 0; mode < 2; mode++) {
+			groupMoveMode = modes[mode];
+			avoidanceSweeps = 0;
+			double orderElapsed = 0.0;
+			double walkElapsed = 0.0;
+			double spread = 0.0;
+			double distanceLeft = 0.0;
+			int finished = 0;
+			int stuck = 0;
+
+			for (int order = 0; order < orderCount; order++) {
+				SpawnBenchmarkGroup(group, spots[order].first, groupSize, 300000);
+				for (auto && entity : group)
+					entity->groupID = 4;
+
+				Uint64 startCounter = SDL_GetPerformanceCounter();
+				OrderGroupMove(group, spots[order].second->center);
+				orderElapsed += GetElapsedMS(startCounter);
+
+				// DEBUG: spread is the mean distance of the members from their centroid while any are still ordered
+				double orderSpread = 0.0;
+				int spreadSteps = 0;
+				for (int step = 0; step < stepCount; step++) {
+					startCounter = SDL_GetPerformanceCounter();
+					for (auto && entity : group) {
+						Vec2_t oldCenter = entity->center;
+						entity->moveTime = SDL_GetTicks() - 25;
+						Walk(entity);
+						if ((!entity->path.empty() || !entity->leader.expired()) && entity->center == oldCenter)
+							stuck++;
+					}
+					walkElapsed += GetElapsedMS(startCounter);
+
+					bool ordered = false;
+					Vec2_t groupCenter = vec2zero;
+					for (auto && entity : group) {
+						ordered = ordered || !entity->path.empty() || !entity->leader.expired();
+						groupCenter += entity->center;
+					}
+					if (!ordered)
+						continue;
+
+					groupCenter = groupCenter * (1.0f / group.size());
+					for (auto && entity : group) {
+						Vec2_t range = entity->center - groupCenter;
+						orderSpread += SDL_sqrtf(range * range) / group.size();
+					}
+					spreadSteps++;
+				}
+				spread += (spreadSteps ? orderSpread / spreadSteps : 0.0) / orderCount;
+
+				for (auto && entity : group) {
+					distanceLeft += GetDistance(&PointToCell(SDL_Point{ (int)entity->center.x, (int)entity->center.y }), spots[order].second);
+					if (entity->path.empty() && entity->leader.expired())
+						finished++;
+					CancelOrder(entity);
+					ClearCellReferences(entity);
+				}
+			}
+
+			benchmarkLog << "\t" << groupSize << " members, " << modeNames[mode] << ": " << orderElapsed / orderCount << " ms order, " 
+						<< walkElapsed / (orderCount * stepCount) << " ms Walk/step, " 
+						<< (orderElapsed + walkElapsed) / (orderCount * stepCount) << " ms total/step, " 
+						<< (double)avoidanceSweeps / (orderCount * stepCount) << " AvoidCollision sweeps/step, " 
+						<< (double)stuck / (orderCount * stepCount) << " members stuck/step, " 
+						<< spread << " px mean spread, " 
+						<< finished << " of " << orderCount * groupSize << " orders finished, " 
+						<< distanceLeft / (orderCount * groupSize) << " mean distance left to goal\n";
+		}
+	}
+	benchmarkLog << '\n';
+
+	groupMoveMode = oldMode;
 }
 
 //***************
-// RangedThink
+// BenchmarkGroupOrders
+// times one group order as a PathFind per member versus one shared flow field
 //***************
-void RangedThink(std::shared_ptr<GameObject_t> & entity) {
-	// TODO: resolve standing orders
-	Walk(entity);
+void BenchmarkGroupOrders() {
+	static const int groupSizes[] = { 10, 100, 1000 };
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	FlowField_t flowField;
+
+	benchmarkLog << "Group order to one goal cell, PathFind per member vs one flow field\n";
+	for (auto && groupSize : groupSizes) {
+		GetBenchmarkQueries(queries, groupSize, 2);
+		GridCell_t * goalCell = queries.front().second;
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		for (auto && query : queries)
+			PathFind(entity, query.first->center, goalCell->center);
+		double pathFindElapsed = GetElapsedMS(startCounter);
+
+		startCounter = SDL_GetPerformanceCounter();
+		BuildFlowField(flowField, goalCell);
+		double flowFieldElapsed = GetElapsedMS(startCounter);
+
+		benchmarkLog << "\t" << groupSize << " members: PathFind " << pathFindElapsed << " ms, flow field " << flowFieldElapsed << " ms\n";
+	}
+	benchmarkLog << '\n';
 }
 
 //***************
-// MissileThink
+// BenchmarkNearestGoal
+// orders to random clicked cells, solid or walled off ones included,
+// PathFind to the clicked cell vs to its NearestReachableCell
 //***************
-void MissileThink(std::shared_ptr<GameObject_t> & entity) {
-	Fly(entity);
-//	if (CheckLocalCollision(entity, nullptr)) {
-		// TODO: only do damage to goodman
-		// TODO: explode no matter  (begin explosion animation and sound)
-	//	RemoveEntity(entity);
-//	}
+void BenchmarkNearestGoal() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+
+	benchmarkLog << "Orders to 1000 random clicked cells per map, PathFind to the clicked cell vs its NearestReachableCell\n";
+	ForEachBenchmarkMap(17, [&](const char * mapName) {
+		// DEBUG: unlike GetBenchmarkQueries, goals may be solid
+		std::mt19937 generator(18);
+		std::uniform_int_distribution<int> randomCell(0, gridCellCount - 1);
+		queries.clear();
+		while (queries.size() < 1000) {
+			GridCell_t * start = IndexToCell(randomCell(generator));
+			if (!start->solid)
+				queries.push_back(std::make_pair(start, IndexToCell(randomCell(generator))));
+		}
+
+		int found = 0;
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		for (auto && query : queries)
+			found += PathFind(entity, query.first->center, query.second->center);
+		double clickedElapsed = GetElapsedMS(startCounter);
+
+		int snapped = 0;
+		int snappedFound = 0;
+		double snapDistance = 0.0;
+		double snapElapsed = 0.0;
+		startCounter = SDL_GetPerformanceCounter();
+		for (auto && query : queries) {
+			Uint64 snapCounter = SDL_GetPerformanceCounter();
+			GridCell_t * goalCell = NearestReachableCell(query.first, query.second);
+			snapElapsed += GetElapsedMS(snapCounter);
+			if (goalCell == nullptr)
+				continue;
+
+			if (goalCell != query.second) {
+				snapped++;
+				snapDistance += GetDistance(goalCell, query.second) * cellSize / 10.0;
+			}
+			snappedFound += (goalCell == query.first) || PathFind(entity, query.first->center, goalCell->center);
+		}
+		double snappedElapsed = GetElapsedMS(startCounter);
+
+		benchmarkLog << mapName << "\n\tclicked cell: " << clickedElapsed << " ms total, " << found << " orders with a path\n"
+					<< "\tnearest reachable: " << snappedElapsed << " ms total, " << snappedFound << " orders with a path, " 
+					<< snapped << " goals snapped " << (snapped ? snapDistance / snapped : 0.0) << " px on average, " 
+					<< snapElapsed * 1000.0 / queries.size() << " us/snap\n";
+	});
+	benchmarkLog << '\n';
 }
 
 //***************
-// Think
-// master GameObject_t think function
+// BenchmarkPathFindBatch
+// times PathFindBatch over increasing batch sizes and worker thread counts
 //***************
-void Think() {
-	for (auto && entity : entities) {
-		switch (entity->type) {
-			case OBJECTTYPE_GOODMAN: GoodmanThink(entity);  break;
-			case OBJECTTYPE_MELEE: MeleeThink(entity);  break;
-			case OBJECTTYPE_RANGED: RangedThink(entity);  break;
+void BenchmarkPathFindBatch() {
+	static const int batchSizes[] = { 10, 100, 1000, 10000 };
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::vector<PathRequest_t> requests;
+	int oldWorkerCount = pathWorkers.threads.size();
+	int cpuCount = SDL_GetCPUCount();
+
+	benchmarkLog << "PathFindBatch scaling, " << cpuCount << " cores\n";
+	for (int threads = 1; threads <= cpuCount; threads = (threads * 2 > cpuCount && threads < cpuCount) ? cpuCount : threads * 2) {
+		StopPathWorkers();
+		StartPathWorkers(threads - 1);
+
+		for (auto && batchSize : batchSizes) {
+			GetBenchmarkQueries(queries, batchSize, 3);
+			requests.clear();
+			for (auto && query : queries)
+				requests.push_back(PathRequest_t{ std::make_shared<GameObject_t>(), query.first->center, query.second->center, false, 0 });
+
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+			PathFindBatch(requests);
+			double elapsed = GetElapsedMS(startCounter);
+
+			benchmarkLog << "\t" << threads << " threads, " << batchSize << " requests: " << elapsed << " ms, " 
+						<< elapsed * 1000.0 / batchSize << " us/request\n";
 		}
 	}
+	benchmarkLog << '\n';
 
-	for (auto && missile : missiles)
-		MissileThink(missile);
+	StopPathWorkers();
+	StartPathWorkers(oldWorkerCount);
 }
 
 //***************
-// SelectGroup
-// monster selection
+// BenchmarkFirstMoves
+// firstMoves bake time and size, and table lookups vs on-line A*
+// DEBUG: rows are in CellIndex order, reordering cells along corridors would shorten the runs
 //***************
-void SelectGroup(SDL_Point & first, SDL_Point & second) {
-
-	static std::vector<int> idList;
-
-	int firstRow;
-	int firstCol;
-	int secondRow;
-	int secondCol;
-	PointToCell(first, firstRow, firstCol);
-	PointToCell(second, secondRow, secondCol);
+void BenchmarkFirstMoves() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+	decltype(firstMoves) oldFirstMoves = firstMoves;
+
+	firstMoves.budget = SIZE_MAX;
+	benchmarkLog << "First move table vs A*, 1000 random queries per map\n";
+	ForEachBenchmarkMap(31, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 32);
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		BakeFirstMoves(-1);
+		double bakeElapsed = GetElapsedMS(startCounter);
+
+		benchmarkLog << mapName << ", baked in " << bakeElapsed << " ms, " << FirstMovesBytes() << " bytes (" 
+					<< gridCellCount * gridCellCount / 2 << " bytes as packed 4-bit moves), " 
+					<< (double)firstMoves.runs.size() / gridCellCount << " runs/row\n";
+		pathFindMode = PATHFIND_ASTAR;
+		TimeQueries("A*", queries);
+		pathFindMode = PATHFIND_FIRST_MOVES;
+		TimeQueries("first moves", queries);
+	});
+	benchmarkLog << '\n';
+
+	firstMoves = oldFirstMoves;
+	pathFindMode = oldMode;
+}
 
-	// get top-left and bottom-right indexes
-	int startRow	= (firstRow < secondRow) ? firstRow : secondRow;
-	int endRow		= (startRow == firstRow) ? secondRow : firstRow;
-	int startCol	= (firstCol < secondCol) ? firstCol : secondCol;
-	int endCol		= (startCol == firstCol) ? secondCol : firstCol;
+//***************
+// BenchmarkPathRepair
+// a stationary unit blocking the cell 3 steps ahead on each path,
+// detoured with RepairPath vs replanned with a full A* search that avoids it
+//***************
+void BenchmarkPathRepair() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	std::shared_ptr<GameObject_t> entity = std::make_shared<GameObject_t>();
+	std::shared_ptr<GameObject_t> blocker = std::make_shared<GameObject_t>();
+	std::vector<std::pair<Path_t, GridCell_t *>> blockedPaths;
+	Path_t replanned;
+	PathFindMode_t oldMode = pathFindMode;
+
+	entity->guid = 0;
+	entity->type = OBJECTTYPE_MELEE;
+	blocker->guid = 1;
+	blocker->type = OBJECTTYPE_MELEE;
+	pathFindMode = PATHFIND_ASTAR;
+	GetBenchmarkQueries(queries, 1000, 51);
+	for (auto && query : queries) {
+		if (!PathFind(entity, query.first->center, query.second->center) || entity->path.size() < 6)
+			continue;
+		blockedPaths.push_back({ entity->path, entity->path[entity->path.size() - 4] });
+	}
 
-	// add all monsters in the selected area to a group
-	for (int row = startRow; row <= endRow; row++) {
-		for (int col = startCol; col <= endCol; col++) {
-			auto & target = gameGrid.cells[row][col];
-			if (!target.solid) {
+	benchmarkLog << "Path blocked 3 steps ahead by a stationary unit, " << blockedPaths.size() << " paths on graphics/collision.txt\n";
+	for (int pass = 0; pass < 2; pass++) {
+		int found = 0;
+		int addedCost = 0;
+		double expansions = 0.0;
+		double elapsed = 0.0;
+		for (auto && blockedPath : blockedPaths) {
+			blockedPath.second->contents.push_back(blocker);
+			entity->path = blockedPath.first;
+			entity->onPath = true;
 
-				for (auto && entity : target.contents) {
-					if (entity->health <= 0)
-						continue;
-					if (entity->type != OBJECTTYPE_MELEE && entity->type != OBJECTTYPE_RANGED)
-						continue;
+			bool repaired;
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+			if (pass == 0) {
+				repaired = RepairPath(entity);
+			} else {
+				mainSearchContext.Reset();
+				mainSearchContext.Close(CellIndex(blockedPath.second));
+				repaired = AStarSearch(mainSearchContext, entity->path.back(), entity->path.front());
+				if (repaired)
+					BuildPath(mainSearchContext, CellIndex(entity->path.front()), entity->path);
+			}
+			elapsed += GetElapsedMS(startCounter);
 
-					// DEBUG: don't add the same entity twice for those over multiple cells
-					auto checkID = std::find(idList.begin(), idList.end(), entity->guid);
-					if (checkID == idList.end()) {
-						entity->selected = true;
-						entity->groupID = 4;		// TODO: random group number for now, but use available/forced group number tracking
-						groupSelection.push_back(entity);
-						idList.push_back(entity->guid);
-					}
-				}
+			expansions += mainSearchContext.expansions;
+			if (repaired) {
+				found++;
+				addedCost += GetPathCost(entity->path) - GetPathCost(blockedPath.first);
 			}
+			blockedPath.second->contents.pop_back();
 		}
+
+		benchmarkLog << "\t" << (pass == 0 ? "RepairPath: " : "full A* replan: ") << elapsed << " ms total, " 
+					<< elapsed * 1000.0 / blockedPaths.size() << " us/path, " << expansions / blockedPaths.size() << " expansions/path, " 
+					<< found << " detours, " << (found ? (double)addedCost / found : 0.0) << " cost added/detour\n";
 	}
-	idList.clear();
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
 }
 
 //***************
-// ClearGroupSelection
+// BenchmarkNavMesh
+// navMesh build time and node counts, and its paths vs cell-level A*
 //***************
-void ClearGroupSelection() {
-	for (auto && entity : groupSelection) {
-		entity->groupID = -1;
-		entity->selected = false;
-	}
-	groupSelection.clear();
+void BenchmarkNavMesh() {
+	std::vector<std::pair<GridCell_t *, GridCell_t *>> queries;
+	PathFindMode_t oldMode = pathFindMode;
+	bool oldAnyAngle = anyAnglePaths;
+
+	benchmarkLog << "Navigation mesh vs cell-level A*, 1000 random queries per map (total costs are octile lengths)\n";
+	ForEachBenchmarkMap(41, [&](const char * mapName) {
+		GetBenchmarkQueries(queries, 1000, 42);
+
+		Uint64 startCounter = SDL_GetPerformanceCounter();
+		BuildNavMesh();
+		double buildElapsed = GetElapsedMS(startCounter);
+
+		int cells = 0;
+		for (int index = 0; index < gridCellCount; index++)
+			cells += IndexToCell(index)->solid ? 0 : 1;
+
+		benchmarkLog << mapName << ", built in " << buildElapsed << " ms, " << navMesh.regions.size() << " regions and " 
+					<< navMesh.portals.size() << " portals for " << cells << " cells\n";
+		pathFindMode = PATHFIND_ASTAR;
+		anyAnglePaths = false;
+		TimeQueries("A*", queries);
+		anyAnglePaths = true;
+		TimeQueries("A* + SmoothPath", queries);
+		pathFindMode = PATHFIND_NAVMESH;
+		anyAnglePaths = false;
+		TimeQueries("navmesh + funnel", queries);
+	});
+	benchmarkLog << '\n';
+
+	pathFindMode = oldMode;
+	anyAnglePaths = oldAnyAngle;
 }
 
-//-------------------------------------END PER-FRAME FUNCTIONS-----------------------------------------//
+//***************
+// RunBenchmarks
+// -benchmark command line option
+// writes pathfinding timings to benchmark.txt
+//***************
+bool RunBenchmarks() {
+	benchmarkLog.open("benchmark.txt");
+	if (!benchmarkLog.good())
+		return false;
+
+	// DEBUG: repeated queries would otherwise time pathCache instead of the searches,
+	// and path costs are compared cell by cell
+	size_t oldCapacity = pathCache.capacity;
+	bool oldAnyAngle = anyAnglePaths;
+	bool oldSizeAware = sizeAwarePaths;
+	pathCache.capacity = 0;
+	anyAnglePaths = false;
+	sizeAwarePaths = false;
+	BenchmarkOpenSets();
+	BenchmarkNavGraph();
+	BenchmarkSizeAware();
+	BenchmarkJumpPointSearch();
+	BenchmarkHierarchy();
+	BenchmarkBidirectional();
+	BenchmarkLandmarks();
+	BenchmarkGroupOrders();
+	BenchmarkNearestGoal();
+	BenchmarkPathFindBatch();
+	BenchmarkFirstMoves();
+	BenchmarkChase();
+	BenchmarkChaseTree();
+	BenchmarkCooperative();
+	BenchmarkGoalSlots();
+	BenchmarkFormation();
+	BenchmarkPathCache();
+	BenchmarkAnyAngle();
+	BenchmarkNavMesh();
+	BenchmarkPathRepair();
+	pathCache.capacity = oldCapacity;
+	anyAnglePaths = oldAnyAngle;
+	sizeAwarePaths = oldSizeAware;
+
+	benchmarkLog.close();
+	return true;
+}
+
+//-------------------------------------END BENCHMARK FUNCTIONS-----------------------------------------//
 //-------------------------------------BEGIN MAIN------------------------------------------------------//
 
 //***************
@@ -1868,6 +7023,25 @@ int __stdcall WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLi
 		SDL_Quit();
 		return 0;
 	}
+	StartPathWorkers(SDL_GetCPUCount() - 1);
+
+	// offline first moves precompute for PATHFIND_FIRST_MOVES, for the unit size of the monsters
+	if (strstr(lpCmdLine, "-bakemoves")) {
+		if (!BakeFirstMoves(sizeAwarePaths ? 0 : -1) || !SaveFirstMoves())
+			SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Don't Be a Hero!", "First moves failed to bake within budget or write", NULL);
+		StopPathWorkers();
+		SDL_Quit();
+		return 0;
+	}
+
+	// pathfinding benchmarks instead of gameplay
+	if (strstr(lpCmdLine, "-benchmark")) {
+		if (!RunBenchmarks())
+			SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "Don't Be a Hero!", "Benchmark failed to write benchmark.txt", NULL);
+		StopPathWorkers();
+		SDL_Quit();
+		return 0;
+	}
 
 	// area select test
 	SDL_Point first, second;
@@ -1930,21 +7104,23 @@ int __stdcall WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLi
 								}
 							}
 
-							// TODO: set all group's monster's goal to goodman's center and continually pathfind to him each frame
-							// TODO: have MELEE types chase and hit him (then back away quickly?)
+							// melee monsters in the group chase him down, see ChaseTarget
+							// TODO: have MELEE types hit him (then back away quickly?)
+							for (auto && entity : groupSelection) {
+								if (entity->type == OBJECTTYPE_MELEE) {
+									CancelOrder(entity);
+									entity->chaseTarget = *findGoodman;
+								}
+							}
 						}
 						
 						// TODO: alternatively if shift is held for down and up click, launch a
 						// stationary attack towards the current mouse location (second point)
 
 						else {
-							// group A* pathfinding
 							// DEBUG: only control one group at a time
 							// TODO: quickly label/re-label and toggle between groups
-							for (auto && entity : groupSelection) {
-								entity->goal = &cell.center;
-								PathFind(entity, SDL_Point{ (int)entity->center.x, (int)entity->center.y }, second);
-							}
+							OrderGroupMove(groupSelection, second);
 						}
 					}
 					break;
@@ -2005,6 +7181,7 @@ int __stdcall WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR lpCmdLi
 	}
 	// end game loop
 
+	StopPathWorkers();
 	SDL_Quit();
 	return 0;
 }